@@ -0,0 +1,45 @@
+import {EventStore} from '../source/ts/event-store';
+import {ResponseType} from '../source/ts/responses';
+import {measure} from './measure';
+
+export async function benchmarkEventStore() {
+  const numEvents = 100000;
+
+  for (const numNames of [1, 100]) {
+    for (const numWaiters of [0, 1000]) {
+      await measure(
+        `event-store: ${numEvents} events, ${numNames} names, ${numWaiters} waiters`,
+        numEvents,
+        async () => {
+          const store = new EventStore();
+          const waiters = Array.from({length: numWaiters}, (_, index) =>
+            store.waitFor(
+              `event-${index % numNames}`,
+              (data) => 'last' in data
+            )
+          );
+
+          for (let index = 0; index < numEvents; index++) {
+            store.add({
+              uuid: '',
+              type: ResponseType.event,
+              name: `event-${index % numNames}`,
+              data: {index},
+            });
+          }
+
+          for (let name = 0; name < numNames; name++) {
+            store.add({
+              uuid: '',
+              type: ResponseType.event,
+              name: `event-${name}`,
+              data: {last: true},
+            });
+          }
+
+          await Promise.all(waiters);
+        }
+      );
+    }
+  }
+}
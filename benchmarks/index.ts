@@ -0,0 +1,9 @@
+import {benchmarkEventStore} from './event-store.bench';
+import {benchmarkResponseStream} from './response-stream.bench';
+
+const run = async () => {
+  await benchmarkEventStore();
+  await benchmarkResponseStream();
+};
+
+run();
@@ -0,0 +1,27 @@
+import {performance} from 'perf_hooks';
+
+const REPEATS = 5;
+
+export async function measure(
+  name: string,
+  operations: number,
+  run: () => Promise<void> | void
+) {
+  await run();
+
+  const timings: number[] = [];
+
+  for (let repeat = 0; repeat < REPEATS; repeat++) {
+    const start = performance.now();
+    await run();
+    timings.push(performance.now() - start);
+  }
+
+  timings.sort((a, b) => a - b);
+  const median = timings[Math.floor(timings.length / 2)];
+  const perSecond = Math.round((operations / median) * 1000);
+
+  console.log(
+    `${name}: ${median.toFixed(2)} ms (${perSecond.toLocaleString()} ops/s)`
+  );
+}
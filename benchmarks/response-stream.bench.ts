@@ -0,0 +1,65 @@
+import {toBuffer} from '../source/ts/binary-protocol';
+import {ResponseStream} from '../source/ts/response-stream';
+import {measure} from './measure';
+
+const CHUNK_SIZE = 64 * 1024;
+
+function split(buffer: Buffer, chunkSize: number): Buffer[] {
+  const chunks: Buffer[] = [];
+  for (let offset = 0; offset < buffer.length; offset += chunkSize) {
+    chunks.push(buffer.subarray(offset, offset + chunkSize));
+  }
+  return chunks;
+}
+
+async function benchmarkChunks(
+  name: string,
+  numResponses: number,
+  chunks: Buffer[]
+) {
+  await measure(name, numResponses, () => {
+    const stream = new ResponseStream();
+    let received = 0;
+
+    stream.on('response', () => received++);
+    stream.on('error', (error) => {
+      throw error;
+    });
+
+    for (const chunk of chunks) {
+      stream.push(chunk);
+    }
+
+    if (received !== numResponses) {
+      throw new Error(`Expected ${numResponses} responses, got ${received}`);
+    }
+  });
+}
+
+export async function benchmarkResponseStream() {
+  const largeSize = 10 * 1024 * 1024;
+  const large = toBuffer({data: 'x'.repeat(largeSize)});
+
+  await benchmarkChunks(
+    `response-stream: 1 x ${largeSize / (1024 * 1024)} MB frame`,
+    1,
+    split(large, CHUNK_SIZE)
+  );
+
+  const numSmall = 100000;
+  const small = Buffer.concat(
+    Array.from({length: numSmall}, (_, index) => toBuffer({index}))
+  );
+
+  await benchmarkChunks(
+    `response-stream: ${numSmall} small frames`,
+    numSmall,
+    split(small, CHUNK_SIZE)
+  );
+
+  await benchmarkChunks(
+    `response-stream: ${numSmall} small frames, 7 byte chunks`,
+    numSmall,
+    split(small, 7)
+  );
+}
@@ -0,0 +1,83 @@
+#include "Benchmark.h"
+
+namespace focusrite::e2e
+{
+[[nodiscard]] static double timeIterations (int iterations,
+                                            const std::function<void ()> & operation)
+{
+    const auto startTicks = juce::Time::getHighResolutionTicks ();
+
+    for (auto iteration = 0; iteration < iterations; ++iteration)
+        operation ();
+
+    const auto elapsedTicks = juce::Time::getHighResolutionTicks () - startTicks;
+    return juce::Time::highResolutionTicksToSeconds (elapsedTicks) * 1.0e9 / iterations;
+}
+
+BenchmarkRunner::BenchmarkRunner (Options options)
+    : _options (std::move (options))
+{
+}
+
+bool BenchmarkRunner::isSelected (const juce::String & name) const
+{
+    return _options.filter.isEmpty () || name.contains (_options.filter);
+}
+
+void BenchmarkRunner::run (const juce::String & name,
+                           const juce::NamedValueSet & parameters,
+                           int iterations,
+                           const std::function<void ()> & operation)
+{
+    if (! isSelected (name))
+        return;
+
+    jassert (iterations > 0);
+
+    juce::ignoreUnused (timeIterations (iterations, operation));
+
+    std::vector<double> timingsNs;
+
+    for (auto repeat = 0; repeat < _options.repeats; ++repeat)
+        timingsNs.push_back (timeIterations (iterations, operation));
+
+    std::sort (timingsNs.begin (), timingsNs.end ());
+
+    juce::DynamicObject::Ptr resultParameters = new juce::DynamicObject ();
+    for (const auto & parameter : parameters)
+        resultParameters->setProperty (parameter.name, parameter.value);
+
+    const auto medianNs = timingsNs [timingsNs.size () / 2];
+
+    auto result = std::make_unique<juce::DynamicObject> ();
+    result->setProperty ("name", name);
+    result->setProperty ("parameters", resultParameters.get ());
+    result->setProperty ("iterations", iterations);
+    result->setProperty ("repeats", _options.repeats);
+    result->setProperty ("min-ns", timingsNs.front ());
+    result->setProperty ("median-ns", medianNs);
+    result->setProperty ("max-ns", timingsNs.back ());
+
+    _results.add (result.release ());
+
+    juce::Logger::writeToLog (name + " " +
+                              juce::JSON::toString (resultParameters.get (), true) + ": " +
+                              juce::String (medianNs, 1) + " ns");
+}
+
+juce::var BenchmarkRunner::toVar () const
+{
+    auto root = std::make_unique<juce::DynamicObject> ();
+    root->setProperty ("juce-version", juce::SystemStats::getJUCEVersion ());
+    root->setProperty ("os", juce::SystemStats::getOperatingSystemName ());
+    root->setProperty ("cpu", juce::SystemStats::getCpuModel ());
+#if JUCE_DEBUG
+    root->setProperty ("build", "debug");
+#else
+    root->setProperty ("build", "release");
+#endif
+    root->setProperty ("benchmarks", _results);
+    return root.release ();
+}
+
+}
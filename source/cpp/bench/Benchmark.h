@@ -0,0 +1,41 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+namespace focusrite::e2e
+{
+// Keeps the compiler from discarding a result that is otherwise unused
+template <typename T>
+void doNotOptimise (const T & value)
+{
+    static volatile const void * sink;
+    sink = &value;
+}
+
+class BenchmarkRunner
+{
+public:
+    struct Options
+    {
+        int repeats = 5;
+        juce::String filter;
+    };
+
+    explicit BenchmarkRunner (Options options);
+
+    // Times `iterations` calls of `operation`, once to warm up and then `repeats` more times,
+    // and records the per-operation duration of each repeat
+    void run (const juce::String & name,
+              const juce::NamedValueSet & parameters,
+              int iterations,
+              const std::function<void ()> & operation);
+
+    [[nodiscard]] bool isSelected (const juce::String & name) const;
+    [[nodiscard]] juce::var toVar () const;
+
+private:
+    const Options _options;
+    juce::Array<juce::var> _results;
+};
+
+}
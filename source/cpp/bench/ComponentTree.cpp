@@ -0,0 +1,83 @@
+#include "ComponentTree.h"
+
+#include <focusrite/e2e/ComponentSearch.h>
+
+namespace focusrite::e2e
+{
+static constexpr auto windowSize = 100;
+
+int TreeShape::getNumNodes () const
+{
+    auto numNodes = 0;
+    auto numAtLevel = 1;
+
+    for (auto level = 0; level < depth; ++level)
+    {
+        numAtLevel *= fanOut;
+        numNodes += numAtLevel;
+    }
+
+    return numNodes;
+}
+
+ComponentTree::ComponentTree (TreeShape shape)
+    : _shape (shape)
+{
+    _nodes.reserve (static_cast<size_t> (shape.getNumNodes ()));
+    addChildren (_root, 0);
+
+    _root.setBounds (0, 0, windowSize, windowSize);
+    _window.addAndMakeVisible (_root);
+    _window.setBounds (0, 0, windowSize, windowSize);
+    _window.setVisible (true);
+}
+
+ComponentTree::~ComponentTree ()
+{
+    // Remove leaves first, so no component is left with a dangling child
+    while (! _nodes.empty ())
+        _nodes.pop_back ();
+}
+
+void ComponentTree::addChildren (juce::Component & parent, int depth)
+{
+    if (depth == _shape.depth)
+        return;
+
+    for (auto index = 0; index < _shape.fanOut; ++index)
+    {
+        auto & node = *_nodes.emplace_back (std::make_unique<juce::Component> ());
+        ComponentSearch::setTestId (node, "node-" + juce::String (_nodes.size () - 1));
+        node.setBounds (parent.getLocalBounds ());
+        parent.addAndMakeVisible (node);
+
+        addChildren (node, depth + 1);
+    }
+}
+
+const juce::Component & ComponentTree::getRoot () const
+{
+    return _root;
+}
+
+int ComponentTree::getNumNodes () const
+{
+    return int (_nodes.size ());
+}
+
+juce::String ComponentTree::getLastNodeId () const
+{
+    return "node-" + juce::String (getNumNodes () - 1);
+}
+
+juce::String ComponentTree::getLastNodePath () const
+{
+    juce::StringArray path;
+
+    for (auto * node = _nodes.back ().get (); node != &_root; node = node->getParentComponent ())
+        path.insert (0, node->getProperties () ["test-id"].toString ());
+
+    return path.joinIntoString ("/");
+}
+
+}
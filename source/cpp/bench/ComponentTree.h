@@ -0,0 +1,39 @@
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+namespace focusrite::e2e
+{
+struct TreeShape
+{
+    int depth = 1;
+    int fanOut = 1;
+
+    [[nodiscard]] int getNumNodes () const;
+};
+
+// A visible window holding `fanOut` children per component, `depth` levels deep. Every node
+// has the test ID "node-<n>", numbered depth first, so the last node is the last one any
+// search visits.
+class ComponentTree
+{
+public:
+    explicit ComponentTree (TreeShape shape);
+    ~ComponentTree ();
+
+    [[nodiscard]] const juce::Component & getRoot () const;
+    [[nodiscard]] int getNumNodes () const;
+
+    [[nodiscard]] juce::String getLastNodeId () const;
+    [[nodiscard]] juce::String getLastNodePath () const;
+
+private:
+    void addChildren (juce::Component & parent, int depth);
+
+    const TreeShape _shape;
+    juce::TopLevelWindow _window {"focusrite-e2e-bench", true};
+    juce::Component _root;
+    std::vector<std::unique_ptr<juce::Component>> _nodes;
+};
+
+}
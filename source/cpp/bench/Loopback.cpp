@@ -0,0 +1,49 @@
+#include "Loopback.h"
+
+#include "../tests/TestHelpers.h"
+
+namespace focusrite::e2e
+{
+Loopback::Loopback ()
+{
+    _listener.createListener (0);
+}
+
+Loopback::~Loopback ()
+{
+    if (_harness)
+        _harness->close ();
+}
+
+int Loopback::getPort () const
+{
+    return _listener.getBoundPort ();
+}
+
+bool Loopback::accept ()
+{
+    if (_listener.waitUntilReady (true, acceptTimeoutMs) == 1)
+        _harness.reset (_listener.waitForNextConnection ());
+
+    if (_harness == nullptr)
+        return false;
+
+    // The app introduces itself before reading any command
+    const auto handshake = readJsonFrame (*_harness);
+    return handshake ["name"].toString () == "handshake";
+}
+
+bool Loopback::isConnected () const
+{
+    return _harness != nullptr && _harness->isConnected ();
+}
+
+juce::String Loopback::roundTrip (const juce::String & commandJson)
+{
+    if (! isConnected () || ! writeFrame (*_harness, commandJson))
+        return {};
+
+    return readFrame (*_harness);
+}
+
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+namespace focusrite::e2e
+{
+// Plays the part of the test harness over a real localhost socket: the TestCentre connects to
+// getPort () as it would in a test run, and commands are framed and written exactly as the
+// JavaScript library does, so each round trip takes the production path through the app
+class Loopback
+{
+public:
+    Loopback ();
+    ~Loopback ();
+
+    [[nodiscard]] int getPort () const;
+
+    // Waits for the TestCentre to connect and reads its handshake
+    [[nodiscard]] bool accept ();
+
+    [[nodiscard]] bool isConnected () const;
+
+    // Sends the command and blocks until its response has been read back
+    [[nodiscard]] juce::String roundTrip (const juce::String & commandJson);
+
+private:
+    juce::StreamingSocket _listener;
+    std::unique_ptr<juce::StreamingSocket> _harness;
+};
+
+}
@@ -0,0 +1,282 @@
+#include "../source/ConnectedTestCentre.h"
+#include "../tests/TestHelpers.h"
+#include "Benchmark.h"
+#include "ComponentTree.h"
+#include "Loopback.h"
+
+#include <focusrite/e2e/Command.h>
+#include <focusrite/e2e/ComponentSearch.h>
+#include <focusrite/e2e/Response.h>
+#include <focusrite/e2e/TestCentre.h>
+#include <future>
+#include <iostream>
+
+namespace focusrite::e2e
+{
+static constexpr auto defaultMaxNodes = 1'000'000;
+static constexpr auto searchVisitsPerBenchmark = 2'000'000;
+static constexpr auto jsonIterations = 10'000;
+static constexpr auto roundTripIterations = 1'000;
+
+static constexpr auto exampleCommand = R"identifier(
+{
+    "type": "get-component-visibility",
+    "uuid": "beb16073-dbcd-49aa-b7d1-9466582a1e0e",
+    "args": {
+        "component-id": "node-999",
+        "skip": 0
+    }
+}
+)identifier";
+
+static constexpr auto exampleAnyThreadCommand = R"identifier(
+{
+    "type": "get-metrics",
+    "uuid": "beb16073-dbcd-49aa-b7d1-9466582a1e0e",
+    "args": {}
+}
+)identifier";
+
+[[nodiscard]] static juce::String getOption (const juce::StringArray & arguments,
+                                             const juce::String & option)
+{
+    for (const auto & argument : arguments)
+        if (argument.startsWith (option))
+            return argument.substring (option.length ());
+
+    return {};
+}
+
+[[nodiscard]] static juce::NamedValueSet describe (const TreeShape & shape)
+{
+    juce::NamedValueSet parameters;
+    parameters.set ("nodes", shape.getNumNodes ());
+    parameters.set ("depth", shape.depth);
+    parameters.set ("fan-out", shape.fanOut);
+    return parameters;
+}
+
+static void benchmarkComponentSearch (BenchmarkRunner & runner, int maxNodes)
+{
+    static const std::vector<TreeShape> shapes {
+        {1, 1000},
+        {1000, 1},
+        {10, 2},
+        {4, 10},
+        {2, 316},
+        {5, 10},
+        {6, 10},
+    };
+
+    for (const auto & shape : shapes)
+    {
+        if (shape.getNumNodes () > maxNodes)
+            continue;
+
+        const auto parameters = describe (shape);
+        const auto iterations = std::max (1, searchVisitsPerBenchmark / shape.getNumNodes ());
+
+        runOnMessageQueue (
+            [&]
+            {
+                const ComponentTree tree (shape);
+                const auto lastId = tree.getLastNodeId ();
+                const auto lastPath = tree.getLastNodePath ();
+                const auto wildcard = "*-" + lastId.fromLastOccurrenceOf ("-", false, false);
+
+                runner.run ("find-with-id/exact",
+                            parameters,
+                            iterations,
+                            [&] { doNotOptimise (ComponentSearch::findWithId (lastId)); });
+
+                runner.run ("find-with-id/wildcard",
+                            parameters,
+                            iterations,
+                            [&] { doNotOptimise (ComponentSearch::findWithId (wildcard)); });
+
+                runner.run ("find-with-id/nested-path",
+                            parameters,
+                            iterations,
+                            [&] { doNotOptimise (ComponentSearch::findWithId (lastPath)); });
+
+                runner.run (
+                    "find-with-id/skip",
+                    parameters,
+                    iterations,
+                    [&]
+                    {
+                        doNotOptimise (
+                            ComponentSearch::findWithId ("node-*", tree.getNumNodes () - 1));
+                    });
+
+                runner.run (
+                    "count-child-components",
+                    parameters,
+                    iterations,
+                    [&]
+                    {
+                        doNotOptimise (
+                            ComponentSearch::countChildComponents (tree.getRoot (), "node-*"));
+                    });
+            });
+    }
+}
+
+static void benchmarkJson (BenchmarkRunner & runner)
+{
+    runner.run ("command-from-json",
+                {},
+                jsonIterations,
+                [] { doNotOptimise (Command::fromJson (exampleCommand)); });
+
+    const auto response = Response::ok ()
+                              .withParameter ("showing", true)
+                              .withParameter ("exists", true)
+                              .withParameter ("text", juce::String::repeatedString ("x", 256));
+
+    runner.run ("response-to-json",
+                {},
+                jsonIterations,
+                [&] { doNotOptimise (response.withUuid (juce::Uuid ()).toJson ()); });
+}
+
+static void benchmarkRoundTrip (BenchmarkRunner & runner)
+{
+    if (! runner.isSelected ("round-trip/message-thread") &&
+        ! runner.isSelected ("round-trip/any-thread"))
+        return;
+
+    const TreeShape shape {1, 1000};
+    std::unique_ptr<ComponentTree> tree;
+    std::unique_ptr<TestCentre> testCentre;
+
+    {
+        Loopback loopback;
+
+        runOnMessageQueue (
+            [&]
+            {
+                tree = std::make_unique<ComponentTree> (shape);
+                testCentre = createConnectedTestCentre (loopback.getPort ());
+            });
+
+        if (! loopback.accept ())
+        {
+            juce::Logger::writeToLog ("Skipping round-trip: could not open a loopback socket");
+        }
+        else
+        {
+            runner.run ("round-trip/message-thread",
+                        describe (shape),
+                        roundTripIterations,
+                        [&] { doNotOptimise (loopback.roundTrip (exampleCommand)); });
+
+            runner.run ("round-trip/any-thread",
+                        {},
+                        roundTripIterations,
+                        [&] { doNotOptimise (loopback.roundTrip (exampleAnyThreadCommand)); });
+        }
+    }
+
+    runOnMessageQueue (
+        [&]
+        {
+            testCentre.reset ();
+            tree.reset ();
+        });
+}
+
+static void runBenchmarks (const juce::StringArray & arguments)
+{
+    const auto maxNodesOption = getOption (arguments, "--max-nodes=");
+    const auto repeatsOption = getOption (arguments, "--repeats=");
+    const auto outputPath = getOption (arguments, "--output=");
+
+    BenchmarkRunner::Options options;
+    options.filter = getOption (arguments, "--filter=");
+
+    if (repeatsOption.isNotEmpty ())
+        options.repeats = std::max (1, repeatsOption.getIntValue ());
+
+    const auto maxNodes =
+        maxNodesOption.isNotEmpty () ? maxNodesOption.getIntValue () : defaultMaxNodes;
+
+    BenchmarkRunner runner (options);
+
+    benchmarkComponentSearch (runner, maxNodes);
+    benchmarkJson (runner);
+    benchmarkRoundTrip (runner);
+
+    const auto json = juce::JSON::toString (runner.toVar ());
+
+    if (outputPath.isNotEmpty ())
+        juce::File::getCurrentWorkingDirectory ().getChildFile (outputPath).replaceWithText (json);
+    else
+        std::cout << json << std::endl;
+}
+
+}
+
+class Application : public juce::JUCEApplicationBase
+{
+public:
+    const juce::String getApplicationName () override // NOLINT
+    {
+        return "focusrite-e2e-bench";
+    }
+
+    const juce::String getApplicationVersion () override // NOLINT
+    {
+        return {};
+    }
+
+    bool moreThanOneInstanceAllowed () override
+    {
+        return true;
+    }
+
+    void initialise ([[maybe_unused]] const juce::String & commandLineArguments) override
+    {
+        _benchmarks = std::async (std::launch::async,
+                                  [arguments = getCommandLineParameterArray ()]
+                                  {
+                                      focusrite::e2e::runBenchmarks (arguments);
+                                      juce::JUCEApplicationBase::quit ();
+                                  });
+    }
+
+    void shutdown () override
+    {
+        _benchmarks.get ();
+    }
+
+    void anotherInstanceStarted ([[maybe_unused]] const juce::String & commandLineArgs) override
+    {
+    }
+
+    void systemRequestedQuit () override
+    {
+    }
+
+    void suspended () override
+    {
+    }
+
+    void resumed () override
+    {
+    }
+
+    void unhandledException (const std::exception * exception,
+                             const juce::String & sourceFile,
+                             int lineNumber) override
+    {
+        juce::Logger::writeToLog ("Unhandled exception in " + sourceFile + "(" +
+                                  juce::String (lineNumber) + "): " + exception->what ());
+        juce::JUCEApplicationBase::setApplicationReturnValue (1);
+    }
+
+private:
+    std::future<void> _benchmarks;
+};
+
+START_JUCE_APPLICATION (Application)
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <focusrite/e2e/Command.h>
+#include <focusrite/e2e/Response.h>
+#include <memory>
+
+namespace focusrite::e2e
+{
+class Responder
+{
+public:
+    virtual ~Responder () = default;
+
+    // May be called from any thread; only the first response is sent
+    virtual void respond (const Response & response) = 0;
+
+    [[nodiscard]] virtual bool hasResponded () const = 0;
+};
+
+class AsyncCommandHandler
+{
+public:
+    virtual ~AsyncCommandHandler () = default;
+
+    // Return true to take ownership of the command and respond later through the responder
+    virtual bool process (const Command & command, std::shared_ptr<Responder> responder) = 0;
+
+    [[nodiscard]] virtual juce::RelativeTime getTimeout (const Command & command) const
+    {
+        juce::ignoreUnused (command);
+
+        static constexpr auto defaultTimeoutSeconds = 30.0;
+        return juce::RelativeTime::seconds (defaultTimeoutSeconds);
+    }
+};
+
+}
@@ -8,17 +8,20 @@ class Command
 {
 public:
     static Command fromJson (const juce::String & json);
+    static Command create (const juce::String & type, const juce::var & args = {});
+    static Command
+    create (const juce::String & type, const juce::Uuid & uuid, const juce::var & args = {});
 
     [[nodiscard]] bool isValid () const;
 
     [[nodiscard]] juce::String getType () const;
     [[nodiscard]] juce::Uuid getUuid () const;
-    [[nodiscard]] juce::String getArgument (const juce::String & argument) const;
-    [[nodiscard]] juce::var getArgumentAsVar (const juce::String & argument) const;
+    [[nodiscard]] juce::String getArgument (const juce::Identifier & argument) const;
+    [[nodiscard]] juce::var getArgumentAsVar (const juce::Identifier & argument) const;
     [[nodiscard]] juce::var getArgs () const;
 
     template <typename T>
-    [[nodiscard]] T getArgumentAs (const juce::String & argument) const;
+    [[nodiscard]] T getArgumentAs (const juce::Identifier & argument) const;
 
     [[nodiscard]] juce::String describe () const;
 
@@ -32,7 +35,7 @@ private:
 };
 
 template <typename T>
-[[nodiscard]] T Command::getArgumentAs (const juce::String & argument) const
+[[nodiscard]] T Command::getArgumentAs (const juce::Identifier & argument) const
 {
     return T (getArgumentAsVar (argument));
 }
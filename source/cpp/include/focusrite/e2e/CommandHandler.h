@@ -11,9 +11,23 @@ class Command;
 class CommandHandler
 {
 public:
+    enum class ThreadAffinity
+    {
+        messageThread,
+        anyThread,
+    };
+
     virtual ~CommandHandler () = default;
 
     virtual std::optional<Response> process (const Command & command) = 0;
+
+    // Commands with anyThread affinity are processed on the connection thread, so must not touch
+    // the GUI or block for long
+    [[nodiscard]] virtual ThreadAffinity getThreadAffinity (const Command & command) const
+    {
+        juce::ignoreUnused (command);
+        return ThreadAffinity::messageThread;
+    }
 };
 
 }
\ No newline at end of file
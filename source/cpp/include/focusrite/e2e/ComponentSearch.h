@@ -14,6 +14,7 @@ public:
                                      const juce::String & matchingId);
 
     static void setTestId (juce::Component & component, const juce::String & id);
+    static juce::String getTestId (const juce::Component & component);
     static void setWindowId (juce::TopLevelWindow & window, const juce::String & id);
 };
 
@@ -14,6 +14,9 @@ public:
 
     [[nodiscard]] Event withParameter (const juce::String & name, const juce::var & value) const;
 
+    [[nodiscard]] const juce::String & getName () const;
+    [[nodiscard]] juce::var getData () const;
+
     [[nodiscard]] juce::String toJson () const;
 
     void addParameter (const juce::String & name, const juce::var & value);
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+namespace focusrite::e2e
+{
+class EventPolicy
+{
+public:
+    enum class Type
+    {
+        unlimited,
+        keepLatest,
+        batch,
+    };
+
+    // Every event is sent as soon as it is raised
+    static EventPolicy unlimited ();
+
+    // At most one event per interval; events raised in between replace each other, and the one
+    // that is eventually sent carries a "coalesced" count
+    static EventPolicy keepLatest (juce::RelativeTime minimumInterval);
+
+    // Events are collected and sent once per interval as a single event with an "events" array
+    static EventPolicy batch (juce::RelativeTime interval);
+
+    [[nodiscard]] Type getType () const;
+    [[nodiscard]] juce::RelativeTime getInterval () const;
+
+private:
+    EventPolicy (Type type, juce::RelativeTime interval);
+
+    Type _type = Type::unlimited;
+    juce::RelativeTime _interval;
+};
+
+}
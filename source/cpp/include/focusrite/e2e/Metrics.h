@@ -0,0 +1,66 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <atomic>
+#include <memory>
+
+namespace focusrite::e2e
+{
+class LatencyHistogram;
+
+// Updates are lock-free and allocation-free, so they are safe from any thread, including the
+// audio thread
+class Counter
+{
+public:
+    void increment (juce::int64 amount = 1) noexcept
+    {
+        _value.fetch_add (amount, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] juce::int64 getValue () const noexcept
+    {
+        return _value.load (std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<juce::int64> _value {0};
+};
+
+class Gauge
+{
+public:
+    void set (double value) noexcept
+    {
+        _value.store (value, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] double getValue () const noexcept
+    {
+        return _value.load (std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<double> _value {0.0};
+};
+
+// Records non-negative integer values (e.g. microseconds or voice counts) with ~6% precision
+class Histogram
+{
+public:
+    Histogram ();
+    ~Histogram ();
+
+    Histogram (const Histogram &) = delete;
+    Histogram & operator= (const Histogram &) = delete;
+
+    void record (uint64_t value) noexcept;
+
+    [[nodiscard]] juce::var toVar () const;
+    [[nodiscard]] uint64_t getCount () const noexcept;
+
+private:
+    std::unique_ptr<LatencyHistogram> _histogram;
+};
+
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+
+namespace focusrite::e2e
+{
+// A fixed-size event that can be created and sent without allocating or locking, e.g. from the
+// audio thread. Names longer than maxNameLength are truncated, parameters beyond maxParameters
+// are ignored, and parameter names must outlive the event (e.g. string literals).
+class RealtimeEvent
+{
+public:
+    static constexpr size_t maxNameLength = 31;
+    static constexpr size_t maxParameters = 4;
+
+    RealtimeEvent () noexcept = default;
+    explicit RealtimeEvent (const char * name) noexcept;
+
+    [[nodiscard]] RealtimeEvent withParameter (const char * name, double value) const noexcept;
+
+    [[nodiscard]] const char * getName () const noexcept;
+    [[nodiscard]] juce::int64 getTimestamp () const noexcept;
+    [[nodiscard]] size_t getNumParameters () const noexcept;
+    [[nodiscard]] const char * getParameterName (size_t index) const noexcept;
+    [[nodiscard]] double getParameterValue (size_t index) const noexcept;
+
+private:
+    std::array<char, maxNameLength + 1> _name {};
+    juce::int64 _timestamp = 0;
+    std::array<const char *, maxParameters> _parameterNames {};
+    std::array<double, maxParameters> _parameterValues {};
+    size_t _numParameters = 0;
+};
+
+}
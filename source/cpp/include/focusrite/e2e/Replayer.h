@@ -0,0 +1,51 @@
+#pragma once
+
+#include <focusrite/e2e/TestCentre.h>
+
+namespace focusrite::e2e
+{
+// Replays a session recorded with --e2e-record=<path> through TestCentre::submit, comparing
+// each response and its latency with the recording
+class Replayer
+{
+public:
+    struct Options
+    {
+        // 1 replays at the recorded pace, 2 twice as fast, and 0 as fast as possible
+        double speed = 1.0;
+
+        // Commands of these types are not replayed
+        juce::StringArray skippedCommandTypes {"quit"};
+
+        juce::RelativeTime timeout = juce::RelativeTime::seconds (30.0);
+    };
+
+    struct Report
+    {
+        juce::Result result = juce::Result::ok ();
+        int numCommands = 0;
+        int numSkipped = 0;
+        int numRecordedEvents = 0;
+        double recordedDurationMs = 0.0;
+        double replayedDurationMs = 0.0;
+        juce::var recordedLatency;
+        juce::var replayedLatency;
+        juce::Array<juce::var> mismatches;
+        juce::Array<juce::var> slowest;
+
+        [[nodiscard]] juce::var toVar () const;
+    };
+
+    explicit Replayer (TestCentre & testCentre, Options options = {});
+
+    // Blocks until the whole log has been replayed, so call it from a thread other than the
+    // message thread. Stops early once shouldExit returns true.
+    [[nodiscard]] Report replay (const juce::File & log,
+                                 const std::function<bool ()> & shouldExit = nullptr);
+
+private:
+    TestCentre & _testCentre;
+    const Options _options;
+};
+
+}
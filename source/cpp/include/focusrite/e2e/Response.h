@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <juce_core/juce_core.h>
 
 namespace focusrite::e2e
@@ -10,21 +11,44 @@ public:
     static Response ok ();
     static Response fail (const juce::String & message);
 
-    [[nodiscard]] Response withParameter (const juce::String & name, const juce::var & value) const;
+    [[nodiscard]] Response withParameter (const juce::Identifier & name,
+                                          const juce::var & value) const;
 
     [[nodiscard]] Response withUuid (const juce::Uuid & uuid) const;
 
+    [[nodiscard]] juce::Uuid getUuid () const;
+    [[nodiscard]] juce::Result getResult () const;
+    [[nodiscard]] juce::var getParameter (const juce::Identifier & name) const;
+
     [[nodiscard]] juce::String toJson () const;
+    void writeJson (juce::OutputStream & output) const;
     [[nodiscard]] juce::String describe () const;
 
-    void addParameter (const juce::String & name, const juce::var & value);
+    void addParameter (const juce::Identifier & name, const juce::var & value);
 
 private:
+    struct Parameter
+    {
+        juce::Identifier name;
+        juce::var value;
+    };
+
     explicit Response (juce::Result result);
 
+    [[nodiscard]] Parameter * findParameter (const juce::Identifier & name);
+
+    template <typename Function>
+    void forEachParameter (Function && function) const;
+
+    // Most responses have only a few parameters, which are kept inline so that building and
+    // copying a response doesn't allocate
+    static constexpr size_t numInlineParameters = 6;
+
     juce::Uuid _uuid = juce::Uuid::null ();
     juce::Result _result;
-    std::map<juce::String, juce::var> _parameters;
+    std::array<Parameter, numInlineParameters> _parameters;
+    size_t _numParameters = 0;
+    std::vector<Parameter> _moreParameters;
 };
 
 }
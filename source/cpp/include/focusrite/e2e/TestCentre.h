@@ -1,6 +1,14 @@
 #pragma once
 
+#include <focusrite/e2e/AsyncCommandHandler.h>
+#include <focusrite/e2e/Command.h>
 #include <focusrite/e2e/CommandHandler.h>
+#include <focusrite/e2e/EventPolicy.h>
+#include <focusrite/e2e/Metrics.h>
+#include <focusrite/e2e/RealtimeEvent.h>
+#include <focusrite/e2e/Response.h>
+#include <focusrite/e2e/TimeSource.h>
+#include <future>
 #include <memory>
 #include <optional>
 
@@ -23,7 +31,32 @@ public:
     virtual void addCommandHandler (CommandHandler & handler) = 0;
     virtual void removeCommandHandler (CommandHandler & handler) = 0;
 
+    virtual void addAsyncCommandHandler (AsyncCommandHandler & handler) = 0;
+    virtual void removeAsyncCommandHandler (AsyncCommandHandler & handler) = 0;
+
+    // Dispatches a command through the same handlers as one received from the harness, without
+    // a connection. On the message thread, synchronous handlers have run by the time this
+    // returns; from any other thread, the command is posted to the message thread, so don't
+    // block the message thread waiting for the result.
+    virtual std::future<Response> submit (const Command & command) = 0;
+
     virtual void sendEvent (const Event & event) = 0;
+    virtual void setEventPolicy (const juce::String & eventName, const EventPolicy & policy) = 0;
+
+    // Safe from any thread, including the audio thread. Returns false if the event was dropped
+    // because the queue was full; the harness is told how many were dropped.
+    virtual bool sendRealtimeEvent (const RealtimeEvent & event) noexcept = 0;
+
+    virtual void resetMetrics () = 0;
+
+    // The returned metrics live as long as the TestCentre; look them up once rather than on
+    // every update
+    virtual Counter & getCounter (const juce::String & name) = 0;
+    virtual Gauge & getGauge (const juce::String & name) = 0;
+    virtual Histogram & getHistogram (const juce::String & name) = 0;
+
+    // Lives as long as the TestCentre and is safe to read from any thread
+    [[nodiscard]] virtual const TimeSource & getTimeSource () const = 0;
 };
 
 }
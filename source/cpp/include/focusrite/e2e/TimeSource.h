@@ -0,0 +1,51 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <atomic>
+
+namespace focusrite::e2e
+{
+// A clock that tests can speed up, slow down, pause or step. Read time for animations, debounces
+// and other time-based behaviour from here rather than juce::Time so tests don't have to wait for
+// it in real time. It follows juce::Time::getMillisecondCounterHiRes until the harness changes it,
+// which is only allowed when the app is launched with --e2e-virtual-time.
+//
+// Reading is lock-free and allocation-free, so it is safe from any thread, including the audio
+// thread
+class TimeSource
+{
+public:
+    TimeSource () noexcept;
+
+    TimeSource (const TimeSource &) = delete;
+    TimeSource & operator= (const TimeSource &) = delete;
+
+    [[nodiscard]] double getMillisecondCounterHiRes () const noexcept;
+    [[nodiscard]] double getScale () const noexcept;
+
+    // A scale of 0 stops time, so it only moves when advanced
+    void setScale (double scale) noexcept;
+    void advance (double milliseconds) noexcept;
+
+private:
+    struct Anchor
+    {
+        double realMs = 0.0;
+        double virtualMs = 0.0;
+        double scale = 1.0;
+    };
+
+    [[nodiscard]] Anchor read () const noexcept;
+    [[nodiscard]] static double toVirtualMs (const Anchor & anchor, double realMs) noexcept;
+    void write (const Anchor & anchor) noexcept;
+
+    // Written under the lock; readers retry if the version changes while they read, or is odd
+    // because a write is in progress
+    juce::SpinLock _writeLock;
+    std::atomic<uint32_t> _version {0};
+    std::atomic<double> _realMs;
+    std::atomic<double> _virtualMs;
+    std::atomic<double> _scale {1.0};
+};
+
+}
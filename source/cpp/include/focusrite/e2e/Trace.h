@@ -0,0 +1,31 @@
+#pragma once
+
+namespace focusrite::e2e
+{
+// Spans recorded here appear alongside the command lifecycle when the app is started with
+// --e2e-trace=<path>. Names must outlive the trace, e.g. string literals. Recording never locks or
+// allocates; each thread keeps its latest 65,536 events, and spans from more than 16 threads are
+// ignored.
+class Trace
+{
+public:
+    [[nodiscard]] static bool isEnabled () noexcept;
+
+    static void begin (const char * name, const char * detail = nullptr) noexcept;
+    static void end () noexcept;
+};
+
+class ScopedTrace
+{
+public:
+    explicit ScopedTrace (const char * name, const char * detail = nullptr) noexcept;
+    ~ScopedTrace ();
+
+    ScopedTrace (const ScopedTrace &) = delete;
+    ScopedTrace & operator= (const ScopedTrace &) = delete;
+
+private:
+    const bool _enabled;
+};
+
+}
@@ -0,0 +1,261 @@
+#include "AllocationTracker.h"
+
+#include <new>
+
+namespace focusrite::e2e
+{
+struct ProcessCounts
+{
+    std::atomic<uint64_t> allocations {0};
+    std::atomic<uint64_t> bytes {0};
+};
+
+static constexpr auto numOwners = 2;
+
+static ProcessCounts processCounts [numOwners];
+static std::atomic<uint64_t> processFrees {0};
+
+// Plain data, so reading these never allocates and they are safe to use from operator new
+static thread_local AllocationTracker::Owner threadOwner = AllocationTracker::Owner::app;
+static thread_local AllocationTracker::Counts threadCounts [numOwners];
+
+[[maybe_unused]] static void countAllocation (std::size_t size) noexcept
+{
+    const auto owner = static_cast<size_t> (threadOwner);
+
+    ++threadCounts [owner].allocations;
+    threadCounts [owner].bytes += size;
+
+    processCounts [owner].allocations.fetch_add (1, std::memory_order_relaxed);
+    processCounts [owner].bytes.fetch_add (size, std::memory_order_relaxed);
+}
+
+[[maybe_unused]] static void countFree () noexcept
+{
+    processFrees.fetch_add (1, std::memory_order_relaxed);
+}
+
+[[nodiscard]] static AllocationTracker::Counts operator- (const AllocationTracker::Counts & lhs,
+                                                         const AllocationTracker::Counts & rhs)
+{
+    return {lhs.allocations - rhs.allocations, lhs.bytes - rhs.bytes};
+}
+
+[[nodiscard]] static juce::var toVar (const AllocationTracker::Counts & counts)
+{
+    auto object = std::make_unique<juce::DynamicObject> ();
+    object->setProperty ("allocations", juce::int64 (counts.allocations));
+    object->setProperty ("bytes", juce::int64 (counts.bytes));
+    return object.release ();
+}
+
+std::optional<Response> AllocationTracker::process (const Command & command)
+{
+    if (command.getType () == "start-allocation-tracking")
+        return start ();
+
+    if (command.getType () == "stop-allocation-tracking")
+        return stop ();
+
+    return std::nullopt;
+}
+
+CommandHandler::ThreadAffinity AllocationTracker::getThreadAffinity (const Command & command) const
+{
+    juce::ignoreUnused (command);
+    return ThreadAffinity::anyThread;
+}
+
+bool AllocationTracker::isAvailable () noexcept
+{
+#if FOCUSRITE_E2E_ALLOCATION_TRACKING
+    return true;
+#else
+    return false;
+#endif
+}
+
+AllocationTracker::Counts AllocationTracker::getThreadCounts (Owner owner) noexcept
+{
+    return threadCounts [static_cast<size_t> (owner)];
+}
+
+AllocationTracker::Counts AllocationTracker::getProcessCounts (Owner owner) noexcept
+{
+    const auto & counts = processCounts [static_cast<size_t> (owner)];
+    return {counts.allocations.load (std::memory_order_relaxed),
+            counts.bytes.load (std::memory_order_relaxed)};
+}
+
+uint64_t AllocationTracker::getProcessFrees () noexcept
+{
+    return processFrees.load (std::memory_order_relaxed);
+}
+
+Response AllocationTracker::start ()
+{
+    if (! isAvailable ())
+        return Response::fail ("Allocation tracking isn't built in, configure the library with "
+                               "FOCUSRITE_E2E_ALLOCATION_TRACKING=ON");
+
+    const juce::ScopedLock lock (_lock);
+
+    _commands.clear ();
+    _appAtStart = getProcessCounts (Owner::app);
+    _libraryAtStart = getProcessCounts (Owner::library);
+    _freesAtStart = getProcessFrees ();
+    _tracking = true;
+
+    return Response::ok ();
+}
+
+Response AllocationTracker::stop ()
+{
+    const juce::ScopedLock lock (_lock);
+
+    if (! _tracking)
+        return Response::fail ("Allocation tracking isn't running");
+
+    _tracking = false;
+
+    auto total = std::make_unique<juce::DynamicObject> ();
+    total->setProperty ("app", toVar (getProcessCounts (Owner::app) - _appAtStart));
+    total->setProperty ("library", toVar (getProcessCounts (Owner::library) - _libraryAtStart));
+    total->setProperty ("frees", juce::int64 (getProcessFrees () - _freesAtStart));
+
+    auto commands = std::make_unique<juce::DynamicObject> ();
+
+    for (const auto & [commandType, allocations] : _commands)
+    {
+        auto object = std::make_unique<juce::DynamicObject> ();
+        object->setProperty ("count", allocations.numScopes);
+        object->setProperty ("app", toVar (allocations.app));
+        object->setProperty ("library", toVar (allocations.library));
+        commands->setProperty (commandType, object.release ());
+    }
+
+    return Response::ok ()
+        .withParameter ("process", total.release ())
+        .withParameter ("commands", commands.release ());
+}
+
+void AllocationTracker::record (const juce::String & commandType,
+                                const Counts & app,
+                                const Counts & library)
+{
+    const juce::ScopedLock lock (_lock);
+
+    if (! _tracking)
+        return;
+
+    auto & allocations = _commands [commandType];
+    ++allocations.numScopes;
+    allocations.app.allocations += app.allocations;
+    allocations.app.bytes += app.bytes;
+    allocations.library.allocations += library.allocations;
+    allocations.library.bytes += library.bytes;
+}
+
+AllocationTracker::ScopedOwner::ScopedOwner (Owner owner) noexcept
+    : _previous (threadOwner)
+{
+    threadOwner = owner;
+}
+
+AllocationTracker::ScopedOwner::~ScopedOwner ()
+{
+    threadOwner = _previous;
+}
+
+AllocationTracker::ScopedCommand::ScopedCommand (AllocationTracker & tracker,
+                                                 juce::String commandType)
+    : _tracker (tracker)
+    , _commandType (std::move (commandType))
+    , _app (getThreadCounts (Owner::app))
+    , _library (getThreadCounts (Owner::library))
+{
+}
+
+AllocationTracker::ScopedCommand::~ScopedCommand ()
+{
+    if (_tracker._tracking && _commandType.isNotEmpty ())
+        _tracker.record (_commandType,
+                         getThreadCounts (Owner::app) - _app,
+                         getThreadCounts (Owner::library) - _library);
+}
+
+void AllocationTracker::ScopedCommand::setCommandType (const juce::String & commandType)
+{
+    _commandType = commandType;
+}
+
+}
+
+#if FOCUSRITE_E2E_ALLOCATION_TRACKING
+
+// Only the fundamental forms are replaced; the array, nothrow and sized forms call these
+
+void * operator new (std::size_t size)
+{
+    focusrite::e2e::countAllocation (size);
+
+    for (;;)
+    {
+        if (auto * pointer = std::malloc (size == 0 ? 1 : size))
+            return pointer;
+
+        if (auto handler = std::get_new_handler ())
+            handler ();
+        else
+            throw std::bad_alloc ();
+    }
+}
+
+void * operator new (std::size_t size, std::align_val_t alignment)
+{
+    focusrite::e2e::countAllocation (size);
+
+    const auto align = std::max (static_cast<std::size_t> (alignment), sizeof (void *));
+
+    for (;;)
+    {
+    #if JUCE_WINDOWS
+        if (auto * pointer = _aligned_malloc (size == 0 ? 1 : size, align))
+            return pointer;
+    #else
+        void * pointer = nullptr;
+        if (posix_memalign (&pointer, align, size == 0 ? 1 : size) == 0)
+            return pointer;
+    #endif
+
+        if (auto handler = std::get_new_handler ())
+            handler ();
+        else
+            throw std::bad_alloc ();
+    }
+}
+
+void operator delete (void * pointer) noexcept
+{
+    if (pointer == nullptr)
+        return;
+
+    focusrite::e2e::countFree ();
+    std::free (pointer);
+}
+
+void operator delete (void * pointer, std::align_val_t) noexcept
+{
+    if (pointer == nullptr)
+        return;
+
+    focusrite::e2e::countFree ();
+
+    #if JUCE_WINDOWS
+    _aligned_free (pointer);
+    #else
+    std::free (pointer);
+    #endif
+}
+
+#endif
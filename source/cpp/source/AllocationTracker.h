@@ -0,0 +1,98 @@
+#pragma once
+
+#include <focusrite/e2e/CommandHandler.h>
+#include <map>
+
+namespace focusrite::e2e
+{
+// Counts heap allocations when the library is built with FOCUSRITE_E2E_ALLOCATION_TRACKING,
+// which replaces the global operator new and delete. Each allocation is counted against the
+// thread's current owner, so the library's own overhead can be told apart from the app's.
+//
+// Handles start-allocation-tracking and stop-allocation-tracking, which report the process
+// totals and the allocations made while processing each command type.
+class AllocationTracker final : public CommandHandler
+{
+public:
+    enum class Owner
+    {
+        app,
+        library,
+    };
+
+    struct Counts
+    {
+        uint64_t allocations = 0;
+        uint64_t bytes = 0;
+    };
+
+    std::optional<Response> process (const Command & command) override;
+    [[nodiscard]] ThreadAffinity getThreadAffinity (const Command & command) const override;
+
+    [[nodiscard]] static bool isAvailable () noexcept;
+
+    // Allocations made on this thread since it started, by owner
+    [[nodiscard]] static Counts getThreadCounts (Owner owner) noexcept;
+
+    // Allocations made by any thread since the process started, by owner
+    [[nodiscard]] static Counts getProcessCounts (Owner owner) noexcept;
+    [[nodiscard]] static uint64_t getProcessFrees () noexcept;
+
+    // Counts allocations on this thread against an owner for the scope's lifetime. Threads start
+    // out owned by the app.
+    class ScopedOwner
+    {
+    public:
+        explicit ScopedOwner (Owner owner) noexcept;
+        ~ScopedOwner ();
+
+        ScopedOwner (const ScopedOwner &) = delete;
+        ScopedOwner & operator= (const ScopedOwner &) = delete;
+
+    private:
+        const Owner _previous;
+    };
+
+    // Records the allocations made on this thread during the scope's lifetime against a command
+    // type, if tracking has been started. The type may be set after the scope starts, for
+    // example once the command has been parsed.
+    class ScopedCommand
+    {
+    public:
+        explicit ScopedCommand (AllocationTracker & tracker, juce::String commandType = {});
+        ~ScopedCommand ();
+
+        ScopedCommand (const ScopedCommand &) = delete;
+        ScopedCommand & operator= (const ScopedCommand &) = delete;
+
+        void setCommandType (const juce::String & commandType);
+
+    private:
+        AllocationTracker & _tracker;
+        juce::String _commandType;
+        const Counts _app;
+        const Counts _library;
+    };
+
+private:
+    struct CommandAllocations
+    {
+        int numScopes = 0;
+        Counts app;
+        Counts library;
+    };
+
+    [[nodiscard]] Response start ();
+    [[nodiscard]] Response stop ();
+
+    void record (const juce::String & commandType, const Counts & app, const Counts & library);
+
+    std::atomic<bool> _tracking {false};
+    juce::CriticalSection _lock;
+    std::map<juce::String, CommandAllocations> _commands;
+    Counts _appAtStart;
+    Counts _libraryAtStart;
+    uint64_t _freesAtStart = 0;
+};
+
+}
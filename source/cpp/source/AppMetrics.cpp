@@ -0,0 +1,219 @@
+#include "AppMetrics.h"
+
+#include "AllocationTracker.h"
+#include "LatencyHistogram.h"
+
+#include <focusrite/e2e/Event.h>
+#include <focusrite/e2e/TestCentre.h>
+
+namespace focusrite::e2e
+{
+static constexpr auto minIntervalMs = 10;
+
+Histogram::Histogram ()
+    : _histogram (std::make_unique<LatencyHistogram> ())
+{
+}
+
+Histogram::~Histogram () = default;
+
+void Histogram::record (uint64_t value) noexcept
+{
+    _histogram->record (value);
+}
+
+juce::var Histogram::toVar () const
+{
+    return _histogram->toVar ();
+}
+
+uint64_t Histogram::getCount () const noexcept
+{
+    return _histogram->getCount ();
+}
+
+AppMetrics::AppMetrics (TestCentre & testCentre)
+    : juce::Thread ("App metrics sampler")
+    , _testCentre (testCentre)
+    , _startMs (juce::Time::getMillisecondCounterHiRes ())
+{
+}
+
+AppMetrics::~AppMetrics ()
+{
+    static constexpr auto waitForever = -1;
+    stopThread (waitForever);
+}
+
+std::optional<Response> AppMetrics::process (const Command & command)
+{
+    if (command.getType () == "get-app-metrics")
+        return Response::ok ().withParameter ("metrics", createSnapshot ());
+
+    if (command.getType () == "set-app-metrics-interval")
+        return setInterval (command);
+
+    return std::nullopt;
+}
+
+CommandHandler::ThreadAffinity AppMetrics::getThreadAffinity (const Command & command) const
+{
+    juce::ignoreUnused (command);
+    return ThreadAffinity::anyThread;
+}
+
+Counter & AppMetrics::getCounter (const juce::String & name)
+{
+    const juce::ScopedLock lock (_lock);
+    return _counters [name].metric;
+}
+
+Gauge & AppMetrics::getGauge (const juce::String & name)
+{
+    const juce::ScopedLock lock (_lock);
+    return _gauges [name].metric;
+}
+
+Histogram & AppMetrics::getHistogram (const juce::String & name)
+{
+    const juce::ScopedLock lock (_lock);
+    return _histograms [name].metric;
+}
+
+Response AppMetrics::setInterval (const Command & command)
+{
+    const auto intervalMs = int (command.getArgumentAsVar ("interval-ms"));
+    if (intervalMs < 0)
+        return Response::fail ("Invalid interval-ms");
+
+    _intervalMs = intervalMs == 0 ? 0 : std::max (minIntervalMs, intervalMs);
+
+    if (! isThreadRunning ())
+        startThread ();
+
+    notify ();
+
+    return Response::ok ().withParameter ("interval-ms", _intervalMs.load ());
+}
+
+void AppMetrics::run ()
+{
+    const AllocationTracker::ScopedOwner owner (AllocationTracker::Owner::library);
+
+    while (! threadShouldExit ())
+    {
+        const auto intervalMs = _intervalMs.load ();
+
+        if (intervalMs == 0)
+        {
+            static constexpr auto waitUntilNotified = -1;
+            wait (waitUntilNotified);
+            continue;
+        }
+
+        wait (intervalMs);
+
+        if (threadShouldExit () || _intervalMs == 0)
+            continue;
+
+        const auto delta = createDelta ();
+        if (delta.isVoid ())
+            continue;
+
+        const auto timeMs = juce::Time::getMillisecondCounterHiRes () - _startMs;
+        _testCentre.sendEvent (Event ("app-metrics")
+                                   .withParameter ("time-ms", timeMs)
+                                   .withParameter ("metrics", delta));
+    }
+}
+
+juce::var AppMetrics::createSnapshot ()
+{
+    const juce::ScopedLock lock (_lock);
+
+    auto counters = std::make_unique<juce::DynamicObject> ();
+    for (const auto & [name, counter] : _counters)
+        counters->setProperty (name, counter.metric.getValue ());
+
+    auto gauges = std::make_unique<juce::DynamicObject> ();
+    for (const auto & [name, gauge] : _gauges)
+        gauges->setProperty (name, gauge.metric.getValue ());
+
+    auto histograms = std::make_unique<juce::DynamicObject> ();
+    for (const auto & [name, histogram] : _histograms)
+        histograms->setProperty (name, histogram.metric.toVar ());
+
+    auto snapshot = std::make_unique<juce::DynamicObject> ();
+    snapshot->setProperty ("counters", counters.release ());
+    snapshot->setProperty ("gauges", gauges.release ());
+    snapshot->setProperty ("histograms", histograms.release ());
+    return snapshot.release ();
+}
+
+juce::var AppMetrics::createDelta ()
+{
+    const juce::ScopedLock lock (_lock);
+
+    auto changed = false;
+
+    auto counters = std::make_unique<juce::DynamicObject> ();
+    for (auto & [name, counter] : _counters)
+    {
+        const auto value = double (counter.metric.getValue ());
+        const auto previous = counter.lastSample.value_or (0.0);
+
+        if (value != previous)
+        {
+            counters->setProperty (name, value - previous);
+            changed = true;
+        }
+
+        counter.lastSample = value;
+    }
+
+    auto gauges = std::make_unique<juce::DynamicObject> ();
+    for (auto & [name, gauge] : _gauges)
+    {
+        const auto value = gauge.metric.getValue ();
+
+        if (value != gauge.lastSample)
+        {
+            gauges->setProperty (name, value);
+            changed = true;
+        }
+
+        gauge.lastSample = value;
+    }
+
+    auto histograms = std::make_unique<juce::DynamicObject> ();
+    for (auto & [name, histogram] : _histograms)
+    {
+        const auto count = double (histogram.metric.getCount ());
+
+        if (count != histogram.lastSample.value_or (0.0))
+        {
+            histograms->setProperty (name, histogram.metric.toVar ());
+            changed = true;
+        }
+
+        histogram.lastSample = count;
+    }
+
+    if (! changed)
+        return {};
+
+    auto delta = std::make_unique<juce::DynamicObject> ();
+
+    if (! counters->getProperties ().isEmpty ())
+        delta->setProperty ("counters", counters.release ());
+
+    if (! gauges->getProperties ().isEmpty ())
+        delta->setProperty ("gauges", gauges.release ());
+
+    if (! histograms->getProperties ().isEmpty ())
+        delta->setProperty ("histograms", histograms.release ());
+
+    return delta.release ();
+}
+
+}
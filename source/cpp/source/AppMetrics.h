@@ -0,0 +1,54 @@
+#pragma once
+
+#include <focusrite/e2e/CommandHandler.h>
+#include <focusrite/e2e/Metrics.h>
+#include <juce_events/juce_events.h>
+#include <map>
+
+namespace focusrite::e2e
+{
+class TestCentre;
+
+class AppMetrics final
+    : public CommandHandler
+    , private juce::Thread
+{
+public:
+    explicit AppMetrics (TestCentre & testCentre);
+    ~AppMetrics () override;
+
+    AppMetrics (const AppMetrics &) = delete;
+    AppMetrics & operator= (const AppMetrics &) = delete;
+
+    std::optional<Response> process (const Command & command) override;
+    [[nodiscard]] ThreadAffinity getThreadAffinity (const Command & command) const override;
+
+    [[nodiscard]] Counter & getCounter (const juce::String & name);
+    [[nodiscard]] Gauge & getGauge (const juce::String & name);
+    [[nodiscard]] Histogram & getHistogram (const juce::String & name);
+
+private:
+    template <typename Metric>
+    struct Sampled
+    {
+        Metric metric;
+        std::optional<double> lastSample;
+    };
+
+    void run () override;
+
+    [[nodiscard]] Response setInterval (const Command & command);
+    [[nodiscard]] juce::var createSnapshot ();
+    [[nodiscard]] juce::var createDelta ();
+
+    TestCentre & _testCentre;
+    const double _startMs;
+    std::atomic<int> _intervalMs {0};
+
+    juce::CriticalSection _lock;
+    std::map<juce::String, Sampled<Counter>> _counters;
+    std::map<juce::String, Sampled<Gauge>> _gauges;
+    std::map<juce::String, Sampled<Histogram>> _histograms;
+};
+
+}
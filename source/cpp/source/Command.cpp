@@ -21,17 +21,27 @@ Command Command::fromJson (const juce::String & json)
                                            root.getProperty ("args", {}));
 }
 
+Command Command::create (const juce::String & type, const juce::var & args)
+{
+    return Command (type, juce::Uuid (), args);
+}
+
+Command Command::create (const juce::String & type, const juce::Uuid & uuid, const juce::var & args)
+{
+    return Command (type, uuid, args);
+}
+
 bool Command::isValid () const
 {
     return _type.isNotEmpty () && ! _uuid.isNull ();
 }
 
-juce::String Command::getArgument (const juce::String & argument) const
+juce::String Command::getArgument (const juce::Identifier & argument) const
 {
     return _args.getProperty (argument, {}).toString ();
 }
 
-juce::var Command::getArgumentAsVar (const juce::String & argument) const
+juce::var Command::getArgumentAsVar (const juce::Identifier & argument) const
 {
     return _args.getProperty (argument, {});
 }
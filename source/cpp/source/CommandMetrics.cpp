@@ -0,0 +1,118 @@
+#include "CommandMetrics.h"
+
+#include <focusrite/e2e/Trace.h>
+
+namespace focusrite::e2e
+{
+static thread_local int searchDepth = 0;
+static thread_local double searchElapsedMs = 0.0;
+
+[[nodiscard]] static uint64_t toMicroseconds (double milliseconds)
+{
+    return uint64_t (std::max (0.0, milliseconds * 1000.0));
+}
+
+std::optional<Response> CommandMetrics::process (const Command & command)
+{
+    if (command.getType () == "get-metrics")
+        return Response::ok ().withParameter ("commands", toVar ());
+
+    if (command.getType () == "reset-metrics")
+    {
+        reset ();
+        return Response::ok ();
+    }
+
+    return std::nullopt;
+}
+
+CommandHandler::ThreadAffinity CommandMetrics::getThreadAffinity (const Command & command) const
+{
+    juce::ignoreUnused (command);
+    return ThreadAffinity::anyThread;
+}
+
+void CommandMetrics::record (const juce::String & commandType, const CommandTiming & timing)
+{
+    auto & histograms = getHistograms (commandType);
+
+    histograms.read.record (toMicroseconds (timing.readMs));
+    histograms.queued.record (toMicroseconds (timing.queuedMs));
+    histograms.search.record (toMicroseconds (timing.searchMs));
+    histograms.handler.record (toMicroseconds (timing.handlerMs));
+    histograms.serialize.record (toMicroseconds (timing.serializeMs));
+    histograms.write.record (toMicroseconds (timing.writeMs));
+}
+
+void CommandMetrics::reset ()
+{
+    const juce::SpinLock::ScopedLockType lock (_lock);
+
+    for (auto & [commandType, histograms] : _histograms)
+        for (auto * histogram : {&histograms->read,
+                                 &histograms->queued,
+                                 &histograms->search,
+                                 &histograms->handler,
+                                 &histograms->serialize,
+                                 &histograms->write})
+            histogram->reset ();
+}
+
+juce::var CommandMetrics::toVar () const
+{
+    const juce::SpinLock::ScopedLockType lock (_lock);
+
+    auto commands = std::make_unique<juce::DynamicObject> ();
+
+    for (const auto & [commandType, histograms] : _histograms)
+    {
+        if (histograms->handler.getCount () == 0)
+            continue;
+
+        auto phases = std::make_unique<juce::DynamicObject> ();
+        phases->setProperty ("count", juce::int64 (histograms->handler.getCount ()));
+        phases->setProperty ("read", histograms->read.toVar ());
+        phases->setProperty ("queued", histograms->queued.toVar ());
+        phases->setProperty ("search", histograms->search.toVar ());
+        phases->setProperty ("handler", histograms->handler.toVar ());
+        phases->setProperty ("serialize", histograms->serialize.toVar ());
+        phases->setProperty ("write", histograms->write.toVar ());
+        commands->setProperty (commandType, phases.release ());
+    }
+
+    return commands.release ();
+}
+
+CommandMetrics::Histograms & CommandMetrics::getHistograms (const juce::String & commandType)
+{
+    const juce::SpinLock::ScopedLockType lock (_lock);
+
+    auto & histograms = _histograms [commandType];
+    if (histograms == nullptr)
+        histograms = std::make_unique<Histograms> ();
+
+    return *histograms;
+}
+
+ScopedSearchTimer::ScopedSearchTimer ()
+    : _startMs (searchDepth == 0 ? juce::Time::getMillisecondCounterHiRes () : 0.0)
+{
+    if (searchDepth++ == 0)
+        Trace::begin ("search");
+}
+
+ScopedSearchTimer::~ScopedSearchTimer ()
+{
+    if (--searchDepth > 0)
+        return;
+
+    searchElapsedMs += juce::Time::getMillisecondCounterHiRes () - _startMs;
+    Trace::end ();
+}
+
+double ScopedSearchTimer::takeElapsedMs ()
+{
+    return std::exchange (searchElapsedMs, 0.0);
+}
+
+}
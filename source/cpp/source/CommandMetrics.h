@@ -0,0 +1,64 @@
+#pragma once
+
+#include "LatencyHistogram.h"
+
+#include <focusrite/e2e/CommandHandler.h>
+#include <map>
+
+namespace focusrite::e2e
+{
+struct CommandTiming
+{
+    double readMs = 0.0;
+    double queuedMs = 0.0;
+    double searchMs = 0.0;
+    double handlerMs = 0.0;
+    double serializeMs = 0.0;
+    double writeMs = 0.0;
+};
+
+class CommandMetrics final : public CommandHandler
+{
+public:
+    std::optional<Response> process (const Command & command) override;
+    [[nodiscard]] ThreadAffinity getThreadAffinity (const Command & command) const override;
+
+    void record (const juce::String & commandType, const CommandTiming & timing);
+    void reset ();
+
+    [[nodiscard]] juce::var toVar () const;
+
+private:
+    struct Histograms
+    {
+        LatencyHistogram read;
+        LatencyHistogram queued;
+        LatencyHistogram search;
+        LatencyHistogram handler;
+        LatencyHistogram serialize;
+        LatencyHistogram write;
+    };
+
+    [[nodiscard]] Histograms & getHistograms (const juce::String & commandType);
+
+    mutable juce::SpinLock _lock;
+    std::map<juce::String, std::unique_ptr<Histograms>> _histograms;
+};
+
+class ScopedSearchTimer
+{
+public:
+    ScopedSearchTimer ();
+    ~ScopedSearchTimer ();
+
+    ScopedSearchTimer (const ScopedSearchTimer &) = delete;
+    ScopedSearchTimer & operator= (const ScopedSearchTimer &) = delete;
+
+    // Returns the time spent in ComponentSearch on this thread since the last call
+    [[nodiscard]] static double takeElapsedMs ();
+
+private:
+    const double _startMs;
+};
+
+}
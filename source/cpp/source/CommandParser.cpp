@@ -0,0 +1,352 @@
+#include "CommandParser.h"
+
+#include <charconv>
+
+namespace focusrite::e2e
+{
+static constexpr size_t maxNumberLength = 32;
+static constexpr size_t numUuidDigits = 32;
+
+// A run of characters in the JSON being parsed
+struct Token
+{
+    const char * start = nullptr;
+    const char * end = nullptr;
+
+    [[nodiscard]] size_t size () const noexcept
+    {
+        return size_t (end - start);
+    }
+
+    [[nodiscard]] bool equals (const char * text) const noexcept
+    {
+        const auto length = std::strlen (text);
+        return size () == length && std::memcmp (start, text, length) == 0;
+    }
+};
+
+// Reads the subset of JSON the parser handles directly. A read that doesn't match returns
+// nothing, and the command is then handed to juce::JSON instead.
+class CommandParser::Reader
+{
+public:
+    Reader (const char * json, size_t size) noexcept
+        : _position (json)
+        , _end (json + size)
+    {
+    }
+
+    [[nodiscard]] bool skip (char expected) noexcept
+    {
+        skipWhitespace ();
+
+        if (_position == _end || *_position != expected)
+            return false;
+
+        ++_position;
+        return true;
+    }
+
+    [[nodiscard]] bool skip (const char * word) noexcept
+    {
+        skipWhitespace ();
+
+        const auto length = std::strlen (word);
+        if (size_t (_end - _position) < length || std::memcmp (_position, word, length) != 0)
+            return false;
+
+        _position += length;
+        return true;
+    }
+
+    [[nodiscard]] bool isNext (char expected) noexcept
+    {
+        skipWhitespace ();
+        return _position != _end && *_position == expected;
+    }
+
+    [[nodiscard]] bool isAtEnd () noexcept
+    {
+        skipWhitespace ();
+        return _position == _end;
+    }
+
+    // Strings with escapes aren't read
+    [[nodiscard]] std::optional<Token> readString () noexcept
+    {
+        if (! skip ('"'))
+            return std::nullopt;
+
+        const Token token {_position, std::find (_position, _end, '"')};
+        if (token.end == _end)
+            return std::nullopt;
+
+        _position = token.end + 1;
+
+        const auto isPlain = std::none_of (token.start,
+                                           token.end,
+                                           [] (char character)
+                                           { return character == '\\' || isControl (character); });
+
+        if (! isPlain || ! juce::CharPointer_UTF8::isValidString (token.start, int (token.size ())))
+            return std::nullopt;
+
+        return token;
+    }
+
+    // Integers that fit are read as an int, as juce::JSON does, then as an int64
+    [[nodiscard]] std::optional<juce::var> readNumber () noexcept
+    {
+        skipWhitespace ();
+
+        const Token token {_position, std::find_if_not (_position, _end, isNumberCharacter)};
+        if (token.size () == 0 || token.size () >= maxNumberLength)
+            return std::nullopt;
+
+        _position = token.end;
+
+        char number [maxNumberLength] {};
+        std::copy (token.start, token.end, number);
+
+        const auto isInteger = std::none_of (token.start,
+                                             token.end,
+                                             [] (char character)
+                                             { return character == '.' || character == 'e' ||
+                                                      character == 'E'; });
+
+        if (isInteger)
+        {
+            juce::int64 value = 0;
+            const auto result = std::from_chars (number, number + token.size (), value);
+
+            if (result.ec != std::errc () || result.ptr != number + token.size ())
+                return std::nullopt;
+
+            if (std::numeric_limits<int>::min () <= value &&
+                value <= std::numeric_limits<int>::max ())
+                return juce::var (int (value));
+
+            return juce::var (value);
+        }
+
+        juce::CharPointer_ASCII text (number);
+        const auto value = juce::CharacterFunctions::readDoubleValue (text);
+
+        if (text.getAddress () != number + token.size ())
+            return std::nullopt;
+
+        return juce::var (value);
+    }
+
+private:
+    [[nodiscard]] static bool isControl (char character) noexcept
+    {
+        return static_cast<unsigned char> (character) < 0x20;
+    }
+
+    [[nodiscard]] static bool isNumberCharacter (char character) noexcept
+    {
+        return ('0' <= character && character <= '9') || character == '-' || character == '+' ||
+               character == '.' || character == 'e' || character == 'E';
+    }
+
+    void skipWhitespace () noexcept
+    {
+        while (_position != _end && juce::CharacterFunctions::isWhitespace (*_position))
+            ++_position;
+    }
+
+    const char * _position;
+    const char * const _end;
+};
+
+// Reads the hex digits of a uuid, with or without dashes
+[[nodiscard]] static std::optional<juce::Uuid> parseUuid (const Token & token)
+{
+    juce::uint8 bytes [numUuidDigits / 2] {};
+    size_t numDigits = 0;
+
+    for (const auto * character = token.start; character != token.end; ++character)
+    {
+        if (*character == '-')
+            continue;
+
+        const auto value =
+            juce::CharacterFunctions::getHexDigitValue (juce::juce_wchar (*character));
+        if (value < 0 || numDigits == numUuidDigits)
+            return std::nullopt;
+
+        auto & byte = bytes [numDigits++ / 2];
+        byte = juce::uint8 ((byte << 4) | value);
+    }
+
+    if (numDigits != numUuidDigits)
+        return std::nullopt;
+
+    return juce::Uuid (bytes);
+}
+
+CommandParser::CommandParser ()
+{
+    for (auto & args : _args)
+        args = new juce::DynamicObject ();
+}
+
+Command CommandParser::parse (const char * json, size_t size)
+{
+    Reader reader (json, size);
+
+    if (auto command = parseCommand (reader))
+        return std::move (*command);
+
+    return Command::fromJson (juce::String::fromUTF8 (json, int (size)));
+}
+
+std::optional<Command> CommandParser::parseCommand (Reader & reader)
+{
+    if (! reader.skip ('{'))
+        return std::nullopt;
+
+    juce::String type;
+    std::optional<juce::Uuid> uuid;
+    juce::var args;
+
+    do
+    {
+        const auto key = reader.readString ();
+        if (! key || ! reader.skip (':'))
+            return std::nullopt;
+
+        if (key->equals ("type"))
+        {
+            const auto value = reader.readString ();
+            if (! value)
+                return std::nullopt;
+
+            type = intern (value->start, value->end);
+        }
+        else if (key->equals ("uuid"))
+        {
+            const auto value = reader.readString ();
+            uuid = value ? parseUuid (*value) : std::nullopt;
+
+            if (! uuid)
+                return std::nullopt;
+        }
+        else if (key->equals ("args"))
+        {
+            const auto object = getArgsObject ();
+            if (! parseArgs (reader, *object))
+                return std::nullopt;
+
+            args = object.get ();
+        }
+        else
+        {
+            return std::nullopt;
+        }
+    } while (reader.skip (','));
+
+    if (! reader.skip ('}') || ! reader.isAtEnd () || type.isEmpty () || ! uuid)
+        return std::nullopt;
+
+    _lastType = type;
+    return Command::create (type, *uuid, args);
+}
+
+// The object is updated in place, so when the arguments have the same names as last time the
+// object was used, none of its storage changes
+bool CommandParser::parseArgs (Reader & reader, juce::DynamicObject & args)
+{
+    if (! reader.skip ('{'))
+        return false;
+
+    auto & properties = args.getProperties ();
+    auto numProperties = 0;
+
+    if (! reader.isNext ('}'))
+    {
+        do
+        {
+            const auto name = reader.readString ();
+            if (! name || name->size () == 0 || ! reader.skip (':'))
+                return false;
+
+            auto value = parseValue (reader);
+            if (! value)
+                return false;
+
+            const juce::Identifier identifier (juce::CharPointer_UTF8 (name->start),
+                                               juce::CharPointer_UTF8 (name->end));
+
+            if (numProperties < properties.size () &&
+                properties.getName (numProperties) == identifier)
+            {
+                *properties.getVarPointerAt (numProperties) = std::move (*value);
+            }
+            else
+            {
+                // Repeated names are left to juce::JSON
+                for (auto index = 0; index < numProperties; ++index)
+                    if (properties.getName (index) == identifier)
+                        return false;
+
+                while (properties.size () > numProperties)
+                    properties.remove (properties.getName (properties.size () - 1));
+
+                properties.set (identifier, std::move (*value));
+            }
+
+            ++numProperties;
+        } while (reader.skip (','));
+    }
+
+    if (! reader.skip ('}'))
+        return false;
+
+    while (properties.size () > numProperties)
+        properties.remove (properties.getName (properties.size () - 1));
+
+    return true;
+}
+
+std::optional<juce::var> CommandParser::parseValue (Reader & reader)
+{
+    if (reader.isNext ('"'))
+    {
+        const auto value = reader.readString ();
+        if (! value)
+            return std::nullopt;
+
+        return juce::var (intern (value->start, value->end));
+    }
+
+    if (reader.skip ("true"))
+        return juce::var (true);
+
+    if (reader.skip ("false"))
+        return juce::var (false);
+
+    if (reader.skip ("null"))
+        return juce::var ();
+
+    return reader.readNumber ();
+}
+
+// An object is only reused once nothing but the pool holds it, which is once the command it was
+// parsed for has been handled
+juce::DynamicObject::Ptr CommandParser::getArgsObject ()
+{
+    for (auto & args : _args)
+        if (args->getReferenceCount () == 1)
+            return args;
+
+    return new juce::DynamicObject ();
+}
+
+juce::String CommandParser::intern (const char * start, const char * end)
+{
+    return _strings.getPooledString (juce::CharPointer_UTF8 (start), juce::CharPointer_UTF8 (end));
+}
+
+}
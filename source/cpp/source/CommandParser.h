@@ -0,0 +1,41 @@
+#pragma once
+
+#include <array>
+#include <focusrite/e2e/Command.h>
+#include <optional>
+
+namespace focusrite::e2e
+{
+// Parses the commands read from the harness. The usual shape, a type, a uuid and flat
+// arguments, is parsed directly: strings are interned so repeated ones are shared rather than
+// copied, and args objects are taken from a small pool, reusing any that nothing else holds
+// any more. So once it has seen a command, parsing another like it doesn't allocate. Anything
+// else, such as nested arguments or escaped strings, is left to Command::fromJson.
+//
+// Not thread safe; each connection has its own parser.
+class CommandParser
+{
+public:
+    CommandParser ();
+
+    [[nodiscard]] Command parse (const char * json, size_t size);
+
+private:
+    class Reader;
+
+    [[nodiscard]] std::optional<Command> parseCommand (Reader & reader);
+    [[nodiscard]] bool parseArgs (Reader & reader, juce::DynamicObject & args);
+    [[nodiscard]] std::optional<juce::var> parseValue (Reader & reader);
+    [[nodiscard]] juce::DynamicObject::Ptr getArgsObject ();
+    [[nodiscard]] juce::String intern (const char * start, const char * end);
+
+    static constexpr size_t numPooledArgs = 4;
+
+    juce::StringPool _strings;
+    std::array<juce::DynamicObject::Ptr, numPooledArgs> _args;
+
+    // Keeps the last type in the pool, which otherwise drops strings nothing else holds
+    juce::String _lastType;
+};
+
+}
@@ -1,3 +1,5 @@
+#include "CommandMetrics.h"
+
 #include <focusrite/e2e/ComponentSearch.h>
 
 namespace focusrite::e2e
@@ -5,28 +7,24 @@ namespace focusrite::e2e
 static constexpr auto testId = "test-id";
 static constexpr auto windowId = "window-id";
 
-[[nodiscard]] static std::vector<juce::Component *>
-getDirectDescendantsMatching (juce::Component & parent,
-                              const std::function<bool (juce::Component &)> & predicate)
-{
-    auto children = parent.getChildren ();
-    children.removeIf ([&] (auto && child) { return child == nullptr || ! predicate (*child); });
-    return {children.begin (), children.end ()};
-}
-
+// A component's matching children come before any of their descendants, and skip counts matches
+// in that order. Nothing is copied on the way, so a search doesn't allocate.
+template <typename Predicate>
 [[nodiscard]] static juce::Component *
-matchChildComponent (juce::Component & component,
-                     const std::function<bool (juce::Component &)> & predicate,
-                     int & skip)
+matchChildComponent (juce::Component & component, const Predicate & predicate, int & skip)
 {
     jassert (skip >= 0);
 
-    auto matchingChildren = getDirectDescendantsMatching (component, predicate);
+    for (auto * child : component.getChildren ())
+    {
+        if (child == nullptr || ! predicate (*child))
+            continue;
 
-    if (skip < int (matchingChildren.size ()))
-        return matchingChildren [static_cast<std::size_t> (skip)];
+        if (skip == 0)
+            return child;
 
-    skip -= int (matchingChildren.size ());
+        --skip;
+    }
 
     for (auto * child : component.getChildren ())
     {
@@ -40,10 +38,9 @@ matchChildComponent (juce::Component & component,
     return nullptr;
 }
 
+template <typename Predicate>
 [[nodiscard]] static juce::Component *
-findChildComponent (juce::Component & component,
-                    const std::function<bool (juce::Component &)> & predicate,
-                    int skip = 0)
+findChildComponent (juce::Component & component, const Predicate & predicate, int skip = 0)
 {
     return matchChildComponent (component, predicate, skip);
 }
@@ -60,19 +57,21 @@ findChildComponent (juce::Component & component,
     return windows;
 }
 
-[[nodiscard]] static juce::Component *
-findComponent (const std::function<bool (juce::Component &)> & predicate, int skip = 0)
+template <typename Predicate>
+[[nodiscard]] static juce::Component * findComponent (const Predicate & predicate, int skip = 0)
 {
-    for (auto & window : getTopLevelWindows ())
-        if (auto * component = findChildComponent (*window, predicate, skip))
-            return component;
+    for (int windowIndex = 0; windowIndex < juce::TopLevelWindow::getNumTopLevelWindows ();
+         ++windowIndex)
+        if (auto * window = juce::TopLevelWindow::getTopLevelWindow (windowIndex))
+            if (auto * component = findChildComponent (*window, predicate, skip))
+                return component;
 
     return nullptr;
 }
 
 [[nodiscard]] static bool componentHasMatchingProperty (const juce::Component & component,
                                                         const juce::String & pattern,
-                                                        const juce::String & propertyName)
+                                                        const juce::Identifier & propertyName)
 {
     const auto componentTestId =
         component.getProperties ().getWithDefault (propertyName, {}).toString ();
@@ -94,8 +93,7 @@ findComponent (const std::function<bool (juce::Component &)> & predicate, int sk
     return componentHasMatchingProperty (window, idPattern, windowId);
 }
 
-[[nodiscard]] static std::function<bool (juce::Component &)>
-createComponentMatcher (const juce::String & componentId)
+[[nodiscard]] static auto createComponentMatcher (const juce::String & componentId)
 {
     return [componentId] (auto && component) -> bool
     {
@@ -106,6 +104,8 @@ createComponentMatcher (const juce::String & componentId)
 
 juce::TopLevelWindow * ComponentSearch::findWindowWithId (const juce::String & id)
 {
+    const ScopedSearchTimer searchTimer;
+
     auto topWindows = getTopLevelWindows ();
     if (topWindows.empty ())
         return nullptr;
@@ -123,6 +123,8 @@ juce::TopLevelWindow * ComponentSearch::findWindowWithId (const juce::String & i
 int ComponentSearch::countChildComponents (const juce::Component & root,
                                            const juce::String & componentId)
 {
+    const ScopedSearchTimer searchTimer;
+
     const auto predicate = createComponentMatcher (componentId);
 
     return std::accumulate (root.getChildren ().begin (),
@@ -141,6 +143,11 @@ int ComponentSearch::countChildComponents (const juce::Component & root,
 
 juce::Component * ComponentSearch::findWithId (const juce::String & componentId, int skip)
 {
+    const ScopedSearchTimer searchTimer;
+
+    if (componentId.isNotEmpty () && ! componentId.containsChar ('/'))
+        return findComponent (createComponentMatcher (componentId), skip);
+
     auto componentIds = juce::StringArray::fromTokens (componentId, "/", "");
     if (componentIds.isEmpty ())
         return nullptr;
@@ -164,6 +171,11 @@ void ComponentSearch::setTestId (juce::Component & component, const juce::String
     component.getProperties ().set (testId, id);
 }
 
+juce::String ComponentSearch::getTestId (const juce::Component & component)
+{
+    return component.getProperties ().getWithDefault (testId, {}).toString ();
+}
+
 void ComponentSearch::setWindowId (juce::TopLevelWindow & window, const juce::String & id)
 {
     window.getProperties ().set (windowId, id);
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <focusrite/e2e/TestCentre.h>
+
+namespace focusrite::e2e
+{
+// Like TestCentre::create, but connects to the given port whatever the command line says
+[[nodiscard]] std::unique_ptr<TestCentre>
+createConnectedTestCentre (int port, TestCentre::LogLevel logLevel = TestCentre::LogLevel::silent);
+
+}
@@ -1,5 +1,9 @@
 #include "Connection.h"
 
+#include "AllocationTracker.h"
+#include "ScratchArena.h"
+
+#include <focusrite/e2e/Trace.h>
 #include <juce_events/juce_events.h>
 
 #if JUCE_MAC
@@ -20,14 +24,14 @@ struct Header
 
 static_assert (sizeof (Header) == 2 * sizeof (uint32_t), "Expecting header to be 8 bytes");
 
-bool writeBytesToSocket (juce::StreamingSocket & socket, const juce::MemoryBlock & data)
+bool writeBytesToSocket (juce::StreamingSocket & socket, const void * data, size_t size)
 {
     int offset = 0;
 
-    while (static_cast<size_t> (offset) < data.getSize ())
+    while (static_cast<size_t> (offset) < size)
     {
-        const auto numBytesWritten =
-            socket.write (&data [offset], static_cast<int> (data.getSize ()) - offset);
+        const auto numBytesWritten = socket.write (static_cast<const char *> (data) + offset,
+                                                   static_cast<int> (size) - offset);
 
         if (numBytesWritten < 0)
             return false;
@@ -42,23 +46,21 @@ bool writeBytesToSocket (juce::StreamingSocket & socket, const juce::MemoryBlock
 
 namespace focusrite::e2e
 {
-std::shared_ptr<Connection> Connection::create (int port)
+std::shared_ptr<Connection> Connection::create (int port, int connectTimeoutMs)
 {
-    return std::shared_ptr<Connection> (new Connection (port));
+    return std::shared_ptr<Connection> (new Connection (port, connectTimeoutMs));
 }
 
-Connection::Connection (int port)
+Connection::Connection (int port, int connectTimeoutMs)
     : Thread ("Test fixture connection")
     , _port (port)
+    , _connectTimeoutMs (connectTimeoutMs)
 {
 }
 
 Connection::~Connection ()
 {
-    closeSocket ();
-
-    constexpr int timeoutMs = 1000;
-    stopThread (timeoutMs);
+    stop ();
 }
 
 void Connection::start ()
@@ -66,14 +68,33 @@ void Connection::start ()
     startThread ();
 }
 
+void Connection::stop ()
+{
+    closeSocket ();
+
+    constexpr int timeoutMs = 1000;
+    stopThread (timeoutMs);
+}
+
 void Connection::run ()
 {
+    const AllocationTracker::ScopedOwner owner (AllocationTracker::Owner::library);
+
     preventSigPipeExceptions ();
 
-    const auto connected = _socket.connect ("localhost", _port);
+    std::vector<juce::int64> connectAttemptsMs;
+
+    if (! connect (connectAttemptsMs))
+    {
+        if (! threadShouldExit ())
+            juce::Logger::writeToLog ("Couldn't connect to the test harness on port " +
+                                      juce::String (_port));
 
-    if (! connected)
         return;
+    }
+
+    if (_onConnected)
+        _onConnected (connectAttemptsMs);
 
     try
     {
@@ -98,15 +119,27 @@ void Connection::run ()
                 break;
             }
 
-            juce::MemoryBlock block (header.size);
-            auto bytesRead = _socket.read (block.getData (), int (header.size), true);
+            const auto readStartMs = juce::Time::getMillisecondCounterHiRes ();
+
+            Trace::begin ("receive");
+
+            // Released once the command has been handed over
+            const ScratchArena::Scope scratch;
+            auto * data = static_cast<char *> (ScratchArena::allocate (header.size));
+            auto bytesRead = _socket.read (data, int (header.size), true);
+
+            Trace::end ();
+
             if (bytesRead != int (header.size))
             {
                 closeSocket ();
                 break;
             }
 
-            notifyData (block);
+            if (_onDataReceived)
+                _onDataReceived (data,
+                                 header.size,
+                                 juce::Time::getMillisecondCounterHiRes () - readStartMs);
         }
     }
     catch (...)
@@ -114,19 +147,51 @@ void Connection::run ()
     }
 }
 
-void Connection::send (const juce::MemoryBlock & data)
+// Waits longer after each failed attempt, up to a limit, so a harness that's slow to start
+// listening isn't flooded while one that's ready is found quickly
+bool Connection::connect (std::vector<juce::int64> & attemptsMs)
+{
+    static constexpr auto initialRetryDelayMs = 10;
+    static constexpr auto maxRetryDelayMs = 500;
+
+    const auto deadlineMs = juce::Time::getMillisecondCounterHiRes () + _connectTimeoutMs;
+    auto retryDelayMs = initialRetryDelayMs;
+
+    while (! threadShouldExit ())
+    {
+        attemptsMs.push_back (juce::Time::currentTimeMillis ());
+
+        const auto remainingMs = deadlineMs - juce::Time::getMillisecondCounterHiRes ();
+        if (_socket.connect ("localhost", _port, std::max (1, int (remainingMs))))
+            return true;
+
+        const auto waitMs = std::min (double (retryDelayMs),
+                                      deadlineMs - juce::Time::getMillisecondCounterHiRes ());
+        if (waitMs <= 0.0)
+            return false;
+
+        wait (int (waitMs));
+        retryDelayMs = std::min (retryDelayMs * 2, maxRetryDelayMs);
+    }
+
+    return false;
+}
+
+void Connection::send (const void * data, size_t size)
 {
     jassert (isConnected ());
 
+    const juce::ScopedLock lock (_writeLock);
+
     if (const Header header {juce::ByteOrder::swapIfBigEndian (Header::magicNumber),
-                             juce::ByteOrder::swapIfBigEndian (uint32_t (data.getSize ()))};
-        ! writeBytesToSocket (_socket, {&header, sizeof (header)}))
+                             juce::ByteOrder::swapIfBigEndian (uint32_t (size))};
+        ! writeBytesToSocket (_socket, &header, sizeof (header)))
     {
         closeSocket ();
         return;
     }
 
-    if (! writeBytesToSocket (_socket, data))
+    if (! writeBytesToSocket (_socket, data, size))
         closeSocket ();
 }
 
@@ -141,17 +206,6 @@ void Connection::closeSocket ()
         _socket.close ();
 }
 
-void Connection::notifyData (const juce::MemoryBlock & data)
-{
-    juce::MessageManager::callAsync (
-        [weakSelf = weak_from_this (), data]
-        {
-            if (auto connection = weakSelf.lock ())
-                if (connection->_onDataReceived)
-                    connection->_onDataReceived (data);
-        });
-}
-
 void Connection::preventSigPipeExceptions ()
 {
 #if JUCE_MAC
@@ -9,7 +9,11 @@ class Connection
     , public std::enable_shared_from_this<Connection>
 {
 public:
-    static std::shared_ptr<Connection> create (int port);
+    static constexpr auto defaultConnectTimeoutMs = 10'000;
+
+    // Keeps trying to connect until the timeout, as the harness may not be listening yet
+    static std::shared_ptr<Connection> create (int port,
+                                               int connectTimeoutMs = defaultConnectTimeoutMs);
 
     ~Connection () override;
 
@@ -17,23 +21,31 @@ public:
     Connection (Connection &&) = delete;
     Connection & operator= (const Connection &) = delete;
 
-    std::function<void (juce::MemoryBlock)> _onDataReceived;
+    // Called on the connection's thread before anything is read, with the time each attempt to
+    // connect started, in milliseconds since the epoch
+    std::function<void (const std::vector<juce::int64> & connectAttemptsMs)> _onConnected;
+
+    // The data is only valid during the call
+    std::function<void (const char * data, size_t size, double readMs)> _onDataReceived;
 
     void start ();
-    void send (const juce::MemoryBlock & data);
+    void stop ();
+    void send (const void * data, size_t size);
     [[nodiscard]] bool isConnected () const;
 
 private:
-    explicit Connection (int port);
+    Connection (int port, int connectTimeoutMs);
 
     void run () override;
+    [[nodiscard]] bool connect (std::vector<juce::int64> & attemptsMs);
 
     void closeSocket ();
     void preventSigPipeExceptions ();
-    void notifyData (const juce::MemoryBlock & data);
 
     int _port = 0;
+    int _connectTimeoutMs = 0;
     juce::StreamingSocket _socket;
+    juce::CriticalSection _writeLock;
 };
 
 }
@@ -1,6 +1,8 @@
 #include "DefaultCommandHandler.h"
 
+#include "AllocationTracker.h"
 #include "KeyPress.h"
+#include "Tracer.h"
 
 #include <focusrite/e2e/ClickableComponent.h>
 #include <focusrite/e2e/Command.h>
@@ -15,16 +17,21 @@ enum class CommandArgument
     componentId,
     focusComponent,
     keyCode,
+    keyframe,
+    maxSize,
+    mode,
     modifiers,
     numClicks,
+    region,
     rootId,
+    scale,
     skip,
     title,
     value,
     windowId,
 };
 
-[[nodiscard]] static juce::StringRef toString (CommandArgument argument)
+[[nodiscard]] static juce::Identifier toString (CommandArgument argument)
 {
     switch (argument)
     {
@@ -34,12 +41,22 @@ enum class CommandArgument
             return "focus-component";
         case CommandArgument::keyCode:
             return "key-code";
+        case CommandArgument::keyframe:
+            return "keyframe";
+        case CommandArgument::maxSize:
+            return "max-size";
+        case CommandArgument::mode:
+            return "mode";
         case CommandArgument::modifiers:
             return "modifiers";
         case CommandArgument::numClicks:
             return "num-clicks";
+        case CommandArgument::region:
+            return "region";
         case CommandArgument::rootId:
             return "root-id";
+        case CommandArgument::scale:
+            return "scale";
         case CommandArgument::skip:
             return "skip";
         case CommandArgument::title:
@@ -54,8 +71,11 @@ enum class CommandArgument
     return {};
 }
 
+// The click runs the app's callbacks, so anything they allocate is counted as the app's
 static void clickButton (juce::Button & button)
 {
+    const AllocationTracker::ScopedOwner owner (AllocationTracker::Owner::app);
+
     if (button.onClick != nullptr)
     {
         if (button.getClickingTogglesState ())
@@ -72,6 +92,8 @@ static void clickButton (juce::Button & button)
 
 static void clickClickableComponent (focusrite::e2e::ClickableComponent & clickable, int numClicks)
 {
+    const AllocationTracker::ScopedOwner owner (AllocationTracker::Owner::app);
+
     if (numClicks == 1)
         clickable.performClick ();
 
@@ -79,22 +101,6 @@ static void clickClickableComponent (focusrite::e2e::ClickableComponent & clicka
         clickable.performDoubleClick ();
 }
 
-[[nodiscard]] static juce::String snapshotComponent (juce::Component & component)
-{
-    auto image = component.createComponentSnapshot (component.getLocalBounds ());
-
-    if (image.isNull ())
-        return {};
-
-    juce::MemoryOutputStream rawStream;
-
-    juce::PNGImageFormat imageFormat;
-    if (! imageFormat.writeImageToStream (image, rawStream))
-        return {};
-
-    return juce::Base64::toBase64 (rawStream.getData (), rawStream.getDataSize ());
-}
-
 [[nodiscard]] static bool clickButton (juce::Component & component)
 {
     if (auto * button = dynamic_cast<juce::Button *> (&component))
@@ -110,6 +116,7 @@ static void clickClickableComponent (focusrite::e2e::ClickableComponent & clicka
 {
     if (auto * textBox = dynamic_cast<juce::TextEditor *> (&component))
     {
+        const AllocationTracker::ScopedOwner owner (AllocationTracker::Owner::app);
         textBox->grabKeyboardFocus ();
         return true;
     }
@@ -159,7 +166,11 @@ static void clickClickableComponent (focusrite::e2e::ClickableComponent & clicka
     if (component == nullptr)
         return Response::fail ("Component not found for key press: " + componentId);
 
-    component->keyPressed (keyPress);
+    {
+        const AllocationTracker::ScopedOwner owner (AllocationTracker::Owner::app);
+        component->keyPressed (keyPress);
+    }
+
     return Response::ok ();
 }
 
@@ -174,7 +185,11 @@ static void clickClickableComponent (focusrite::e2e::ClickableComponent & clicka
     if (peer == nullptr)
         return Response::fail ("Window doesn't have peer");
 
-    peer->handleKeyPress (keyPress);
+    {
+        const AllocationTracker::ScopedOwner owner (AllocationTracker::Owner::app);
+        peer->handleKeyPress (keyPress);
+    }
+
     return Response::ok ();
 }
 
@@ -200,12 +215,46 @@ static void clickClickableComponent (focusrite::e2e::ClickableComponent & clicka
 {
     if (auto * window = ComponentSearch::findWindowWithId (
             command.getArgument (toString (CommandArgument::windowId))))
+    {
+        const AllocationTracker::ScopedOwner owner (AllocationTracker::Owner::app);
         window->grabKeyboardFocus ();
+    }
 
     return Response::ok ();
 }
 
-[[nodiscard]] static Response getScreenshot (const Command & command)
+[[nodiscard]] static juce::Rectangle<int> getScreenshotArea (const juce::Component & component,
+                                                             const Command & command)
+{
+    const auto region = command.getArgumentAsVar (toString (CommandArgument::region));
+    if (! region.isObject ())
+        return component.getLocalBounds ();
+
+    return component.getLocalBounds ().getIntersection ({int (region.getProperty ("x", 0)),
+                                                          int (region.getProperty ("y", 0)),
+                                                          int (region.getProperty ("width", 0)),
+                                                          int (region.getProperty ("height", 0))});
+}
+
+[[nodiscard]] static std::optional<double> getScreenshotScale (const juce::Image & image,
+                                                              const Command & command)
+{
+    const auto scaleArgument = command.getArgumentAsVar (toString (CommandArgument::scale));
+    auto scale = scaleArgument.isVoid () ? 1.0 : double (scaleArgument);
+
+    if (scale <= 0.0)
+        return std::nullopt;
+
+    const auto maxSize = command.getArgument (toString (CommandArgument::maxSize)).getIntValue ();
+    const auto longestSide = std::max (image.getWidth (), image.getHeight ());
+
+    if (maxSize > 0 && longestSide * scale > maxSize)
+        scale = double (maxSize) / longestSide;
+
+    return std::min (scale, 1.0);
+}
+
+[[nodiscard]] static Response getScreenshot (const Command & command, ScreenshotHistory & history)
 {
     const auto componentId = command.getArgument (toString (CommandArgument::componentId));
     const auto windowId = command.getArgument (toString (CommandArgument::windowId));
@@ -216,11 +265,40 @@ static void clickClickableComponent (focusrite::e2e::ClickableComponent & clicka
     if (component == nullptr)
         return Response::fail ("Component not found: " + juce::String (componentId));
 
-    auto image = snapshotComponent (*component);
-    if (image.isEmpty ())
+    const auto area = getScreenshotArea (*component, command);
+    if (area.isEmpty ())
+        return Response::fail ("Screenshot region is outside the component");
+
+    juce::Image image;
+    {
+        // Snapshots run the app's paint code
+        const AllocationTracker::ScopedOwner owner (AllocationTracker::Owner::app);
+        image = component->createComponentSnapshot (area);
+    }
+
+    if (image.isNull ())
         return Response::fail ("Failed to snapshot component");
 
-    return Response::ok ().withParameter ("image", image);
+    const auto scale = getScreenshotScale (image, command);
+    if (! scale)
+        return Response::fail ("Invalid screenshot scale");
+
+    if (*scale < 1.0)
+        image = downscaleImage (image,
+                                std::max (1, juce::roundToInt (image.getWidth () * *scale)),
+                                std::max (1, juce::roundToInt (image.getHeight () * *scale)));
+
+    if (command.getArgument (toString (CommandArgument::mode)) == "delta")
+        return history.createDelta (
+            componentId.isNotEmpty () ? componentId : "window:" + windowId,
+            image,
+            command.getArgumentAs<bool> (toString (CommandArgument::keyframe)));
+
+    const auto encodedImage = encodeImageAsBase64Png (image);
+    if (encodedImage.isEmpty ())
+        return Response::fail ("Failed to snapshot component");
+
+    return Response::ok ().withParameter ("image", encodedImage);
 }
 
 [[nodiscard]] static Response getComponentVisibility (const Command & command)
@@ -238,7 +316,11 @@ static void clickClickableComponent (focusrite::e2e::ClickableComponent & clicka
         showing = component->isShowing ();
     }
 
-    return Response::ok ().withParameter ("exists", exists).withParameter ("showing", showing);
+    // Held here so the names stay pooled between commands
+    static const juce::Identifier existsName ("exists");
+    static const juce::Identifier showingName ("showing");
+
+    return Response::ok ().withParameter (existsName, exists).withParameter (showingName, showing);
 }
 
 [[nodiscard]] static Response getComponentEnablement (const Command & command)
@@ -324,6 +406,16 @@ static void clickClickableComponent (focusrite::e2e::ClickableComponent & clicka
     return Response::ok ();
 }
 
+[[nodiscard]] static Response flushTrace (const Command & command)
+{
+    juce::ignoreUnused (command);
+
+    if (const auto result = Tracer::flush (); result.failed ())
+        return Response::fail (result.getErrorMessage ());
+
+    return Response::ok ().withParameter ("path", Tracer::getFile ().getFullPathName ());
+}
+
 [[nodiscard]] static Response invokeMenu (const Command & command)
 {
     auto * application = juce::JUCEApplication::getInstance ();
@@ -345,7 +437,11 @@ static void clickClickableComponent (focusrite::e2e::ClickableComponent & clicka
         if (info.shortName != menuTitle)
             continue;
 
-        application->invoke (juce::ApplicationCommandTarget::InvocationInfo (commandID), false);
+        {
+            const AllocationTracker::ScopedOwner owner (AllocationTracker::Owner::app);
+            application->invoke (juce::ApplicationCommandTarget::InvocationInfo (commandID), false);
+        }
+
         return Response::ok ();
     }
 
@@ -399,7 +495,10 @@ template <class T>
         if (value > slider->getMaximum () || value < slider->getMinimum ())
             return Response::fail ("Slider value out of range: " + juce::String (value));
 
-        slider->setValue (value, juce::sendNotificationSync);
+        {
+            const AllocationTracker::ScopedOwner owner (AllocationTracker::Owner::app);
+            slider->setValue (value, juce::sendNotificationSync);
+        }
 
         return Response::ok ();
     }
@@ -421,6 +520,7 @@ template <class T>
         if (auto * textEditor = dynamic_cast<juce::TextEditor *> (component))
         {
             static constexpr auto sendTextChangeMessage = true;
+            const AllocationTracker::ScopedOwner owner (AllocationTracker::Owner::app);
             textEditor->setText (text, sendTextChangeMessage);
             return Response::ok ();
         }
@@ -493,7 +593,10 @@ template <class T>
         if (value > comboBox->getNumItems () || value < 0)
             return Response::fail ("ComboBox value out of range: " + juce::String (value));
 
-        comboBox->setSelectedItemIndex (value, juce::sendNotificationSync);
+        {
+            const AllocationTracker::ScopedOwner owner (AllocationTracker::Owner::app);
+            comboBox->setSelectedItemIndex (value, juce::sendNotificationSync);
+        }
 
         return Response::ok ();
     }
@@ -608,13 +711,12 @@ template <class T>
     return Response::fail (componentId + " not found");
 }
 
-std::optional<Response> DefaultCommandHandler::process (const Command & commandToProcess)
-{
-    static const std::map<juce::String, std::function<Response (const Command &)>> commandHandlers =
-        {
+DefaultCommandHandler::DefaultCommandHandler ()
+    : _commandHandlers {
             {"click-component", [&] (auto && command) { return clickComponent (command); }},
             {"key-press", [&] (auto && command) { return keyPress (command); }},
-            {"get-screenshot", [&] (auto && command) { return getScreenshot (command); }},
+            {"get-screenshot",
+             [&] (auto && command) { return getScreenshot (command, _screenshotHistory); }},
             {"get-component-visibility",
              [&] (auto && command) { return getComponentVisibility (command); }},
             {"get-component-enablement",
@@ -624,6 +726,7 @@ std::optional<Response> DefaultCommandHandler::process (const Command & commandT
             {"get-component-count", [&] (auto && command) { return countComponents (command); }},
             {"grab-focus", [&] (auto && command) { return grabFocus (command); }},
             {"quit", [&] (auto && command) { return quit (command); }},
+            {"flush-trace", [&] (auto && command) { return flushTrace (command); }},
             {"invoke-menu", [&] (auto && command) { return invokeMenu (command); }},
             {"get-slider-value", [&] (auto && command) { return getSliderValue (command); }},
             {"set-slider-value", [&] (auto && command) { return setSliderValue (command); }},
@@ -644,13 +747,25 @@ std::optional<Response> DefaultCommandHandler::process (const Command & commandT
              [&] (auto && command) { return getAccessibilityParent (command); }},
             {"get-accessibility-children",
              [&] (auto && command) { return getAccessibilityChildren (command); }},
-        };
+        }
+{
+}
 
-    auto it = commandHandlers.find (commandToProcess.getType ());
+std::optional<Response> DefaultCommandHandler::process (const Command & commandToProcess)
+{
+    auto it = _commandHandlers.find (commandToProcess.getType ());
 
-    if (it == commandHandlers.end ())
+    if (it == _commandHandlers.end ())
         return std::nullopt;
 
     return it->second (commandToProcess);
 }
+
+CommandHandler::ThreadAffinity
+DefaultCommandHandler::getThreadAffinity (const Command & command) const
+{
+    const auto type = command.getType ();
+    return type == "quit" || type == "flush-trace" ? ThreadAffinity::anyThread
+                                                   : ThreadAffinity::messageThread;
+}
 }
@@ -1,13 +1,26 @@
 #pragma once
 
+#include "Screenshot.h"
+
 #include <focusrite/e2e/CommandHandler.h>
+#include <map>
 
 namespace focusrite::e2e
 {
 class DefaultCommandHandler : public CommandHandler
 {
 public:
+    DefaultCommandHandler ();
+
+    DefaultCommandHandler (const DefaultCommandHandler &) = delete;
+    DefaultCommandHandler & operator= (const DefaultCommandHandler &) = delete;
+
     std::optional<Response> process (const Command & command) override;
+    [[nodiscard]] ThreadAffinity getThreadAffinity (const Command & command) const override;
+
+private:
+    std::map<juce::String, std::function<Response (const Command &)>> _commandHandlers;
+    ScreenshotHistory _screenshotHistory;
 };
 
 }
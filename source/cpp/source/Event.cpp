@@ -14,6 +14,21 @@ Event Event::withParameter (const juce::String & name, const juce::var & value)
     return other;
 }
 
+const juce::String & Event::getName () const
+{
+    return _name;
+}
+
+juce::var Event::getData () const
+{
+    auto data = std::make_unique<juce::DynamicObject> ();
+
+    for (const auto & [name, value] : _parameters)
+        data->setProperty (name, value);
+
+    return data.release ();
+}
+
 juce::String Event::toJson () const
 {
     auto root = std::make_unique<juce::DynamicObject> ();
@@ -22,14 +37,7 @@ juce::String Event::toJson () const
     root->setProperty ("name", _name);
 
     if (! _parameters.empty ())
-    {
-        auto data = std::make_unique<juce::DynamicObject> ();
-
-        for (const auto & [name, value] : _parameters)
-            data->setProperty (name, value);
-
-        root->setProperty ("data", data.release ());
-    }
+        root->setProperty ("data", getData ());
 
     return juce::JSON::toString (root.release ());
 }
@@ -0,0 +1,36 @@
+#include <focusrite/e2e/EventPolicy.h>
+
+namespace focusrite::e2e
+{
+EventPolicy::EventPolicy (Type type, juce::RelativeTime interval)
+    : _type (type)
+    , _interval (interval)
+{
+}
+
+EventPolicy EventPolicy::unlimited ()
+{
+    return {Type::unlimited, {}};
+}
+
+EventPolicy EventPolicy::keepLatest (juce::RelativeTime minimumInterval)
+{
+    return {Type::keepLatest, minimumInterval};
+}
+
+EventPolicy EventPolicy::batch (juce::RelativeTime interval)
+{
+    return {Type::batch, interval};
+}
+
+EventPolicy::Type EventPolicy::getType () const
+{
+    return _type;
+}
+
+juce::RelativeTime EventPolicy::getInterval () const
+{
+    return _interval;
+}
+
+}
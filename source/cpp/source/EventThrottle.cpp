@@ -0,0 +1,233 @@
+#include "EventThrottle.h"
+
+#include "AllocationTracker.h"
+
+namespace focusrite::e2e
+{
+static constexpr auto flushIntervalMs = 5;
+
+// Sent by the library itself, and read by the harness one event at a time
+static constexpr const char * reservedNames [] {
+    "app-metrics",
+    "capture-frame",
+    "events-dropped",
+    "handshake",
+    "message-thread-stall",
+    "message-thread-stall-detected",
+};
+
+[[nodiscard]] static Event createBatchEvent (const juce::String & name,
+                                             const juce::Array<juce::var> & batch)
+{
+    return Event (name).withParameter ("count", batch.size ()).withParameter ("events", batch);
+}
+
+bool EventThrottle::isReserved (const juce::String & name)
+{
+    return std::any_of (std::begin (reservedNames),
+                        std::end (reservedNames),
+                        [&] (auto * reservedName) { return name == reservedName; });
+}
+
+EventThrottle::EventThrottle (Sender sender)
+    : juce::Thread ("Event throttle")
+    , _sender (std::move (sender))
+{
+}
+
+EventThrottle::~EventThrottle ()
+{
+    stop ();
+}
+
+std::optional<Response> EventThrottle::process (const Command & command)
+{
+    if (command.getType () == "set-event-policy")
+        return setPolicy (command);
+
+    return std::nullopt;
+}
+
+CommandHandler::ThreadAffinity EventThrottle::getThreadAffinity (const Command & command) const
+{
+    juce::ignoreUnused (command);
+    return ThreadAffinity::anyThread;
+}
+
+Response EventThrottle::setPolicy (const Command & command)
+{
+    const auto name = command.getArgument ("name");
+    if (name.isEmpty ())
+        return Response::fail ("Missing name");
+
+    if (isReserved (name))
+        return Response::fail ("Can't set a policy on the library's own event: " + name);
+
+    const auto policy = command.getArgument ("policy");
+    const auto interval =
+        juce::RelativeTime::milliseconds (int (command.getArgumentAsVar ("interval-ms")));
+
+    if (policy == "unlimited")
+        setPolicy (name, EventPolicy::unlimited ());
+    else if (policy == "keep-latest")
+        setPolicy (name, EventPolicy::keepLatest (interval));
+    else if (policy == "batch")
+        setPolicy (name, EventPolicy::batch (interval));
+    else
+        return Response::fail ("Unknown policy: " + policy);
+
+    return Response::ok ();
+}
+
+void EventThrottle::setPolicy (const juce::String & name, const EventPolicy & policy)
+{
+    if (isReserved (name))
+    {
+        // The harness expects the library's own events one at a time
+        jassertfalse;
+        return;
+    }
+
+    std::vector<Event> pending;
+
+    {
+        const juce::ScopedLock lock (_lock);
+
+        auto & throttled = _throttled [name];
+
+        if (throttled.latest)
+            pending.push_back (
+                throttled.latest->withParameter ("coalesced", throttled.numCoalesced));
+
+        if (! throttled.batch.isEmpty ())
+            pending.push_back (createBatchEvent (name, throttled.batch));
+
+        throttled = {};
+        throttled.policy = policy;
+
+        if (policy.getType () == EventPolicy::Type::unlimited)
+            _throttled.erase (name);
+
+        _hasPolicies = ! _throttled.empty ();
+    }
+
+    for (const auto & event : pending)
+        _sender (event);
+
+    if (_hasPolicies && ! isThreadRunning ())
+        startThread ();
+}
+
+void EventThrottle::send (const Event & event)
+{
+    if (! _hasPolicies)
+    {
+        _sender (event);
+        return;
+    }
+
+    {
+        const juce::ScopedLock lock (_lock);
+
+        auto it = _throttled.find (event.getName ());
+
+        if (it != _throttled.end ())
+        {
+            auto & throttled = it->second;
+
+            const auto nowMs = juce::Time::getMillisecondCounterHiRes ();
+            const auto intervalMs = double (throttled.policy.getInterval ().inMilliseconds ());
+
+            if (throttled.policy.getType () == EventPolicy::Type::batch)
+            {
+                const auto startsNewBatch =
+                    throttled.batch.isEmpty () && nowMs - throttled.lastSentMs >= intervalMs;
+
+                if (startsNewBatch)
+                    throttled.lastSentMs = nowMs;
+
+                throttled.batch.add (event.getData ());
+                return;
+            }
+
+            if (throttled.latest || nowMs - throttled.lastSentMs < intervalMs)
+            {
+                if (throttled.latest)
+                    ++throttled.numCoalesced;
+
+                throttled.latest = event;
+                return;
+            }
+
+            throttled.lastSentMs = nowMs;
+        }
+    }
+
+    _sender (event);
+}
+
+void EventThrottle::stop ()
+{
+    static constexpr auto waitForever = -1;
+    stopThread (waitForever);
+
+    std::vector<Event> pending;
+
+    {
+        const juce::ScopedLock lock (_lock);
+
+        // Everything held back is due now, whatever its interval
+        pending = takeDueEvents (std::numeric_limits<double>::infinity ());
+        _throttled.clear ();
+        _hasPolicies = false;
+    }
+
+    for (const auto & event : pending)
+        _sender (event);
+}
+
+void EventThrottle::run ()
+{
+    const AllocationTracker::ScopedOwner owner (AllocationTracker::Owner::library);
+
+    while (! threadShouldExit ())
+    {
+        wait (flushIntervalMs);
+
+        for (const auto & event : takeDueEvents (juce::Time::getMillisecondCounterHiRes ()))
+            _sender (event);
+    }
+}
+
+std::vector<Event> EventThrottle::takeDueEvents (double nowMs)
+{
+    const juce::ScopedLock lock (_lock);
+
+    std::vector<Event> due;
+
+    for (auto & [name, throttled] : _throttled)
+    {
+        const auto intervalMs = double (throttled.policy.getInterval ().inMilliseconds ());
+
+        if (nowMs - throttled.lastSentMs < intervalMs)
+            continue;
+
+        if (throttled.latest)
+        {
+            due.push_back (throttled.latest->withParameter ("coalesced", throttled.numCoalesced));
+            throttled.latest.reset ();
+            throttled.numCoalesced = 0;
+            throttled.lastSentMs = nowMs;
+        }
+        else if (! throttled.batch.isEmpty ())
+        {
+            due.push_back (createBatchEvent (name, throttled.batch));
+            throttled.batch.clear ();
+            throttled.lastSentMs = nowMs;
+        }
+    }
+
+    return due;
+}
+
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <focusrite/e2e/CommandHandler.h>
+#include <focusrite/e2e/Event.h>
+#include <focusrite/e2e/EventPolicy.h>
+#include <map>
+
+namespace focusrite::e2e
+{
+class EventThrottle final
+    : public CommandHandler
+    , private juce::Thread
+{
+public:
+    using Sender = std::function<void (const Event &)>;
+
+    explicit EventThrottle (Sender sender);
+    ~EventThrottle () override;
+
+    EventThrottle (const EventThrottle &) = delete;
+    EventThrottle & operator= (const EventThrottle &) = delete;
+
+    std::optional<Response> process (const Command & command) override;
+    [[nodiscard]] ThreadAffinity getThreadAffinity (const Command & command) const override;
+
+    // Whether the event is one of the library's own, which can't be given a policy
+    [[nodiscard]] static bool isReserved (const juce::String & name);
+
+    void setPolicy (const juce::String & name, const EventPolicy & policy);
+    void send (const Event & event);
+
+    // Sends everything that's being held back, then lets events through unthrottled until a
+    // policy is set again
+    void stop ();
+
+private:
+    struct Throttled
+    {
+        EventPolicy policy = EventPolicy::unlimited ();
+        double lastSentMs = -std::numeric_limits<double>::infinity ();
+        std::optional<Event> latest;
+        int numCoalesced = 0;
+        juce::Array<juce::var> batch;
+    };
+
+    void run () override;
+
+    [[nodiscard]] Response setPolicy (const Command & command);
+    [[nodiscard]] std::vector<Event> takeDueEvents (double nowMs);
+
+    const Sender _sender;
+
+    juce::CriticalSection _lock;
+    std::map<juce::String, Throttled> _throttled;
+    std::atomic<bool> _hasPolicies {false};
+};
+
+}
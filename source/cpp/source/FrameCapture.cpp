@@ -0,0 +1,195 @@
+#include "FrameCapture.h"
+
+#include "AllocationTracker.h"
+#include "Screenshot.h"
+
+#include <focusrite/e2e/ComponentSearch.h>
+#include <focusrite/e2e/Event.h>
+#include <focusrite/e2e/TestCentre.h>
+
+namespace focusrite::e2e
+{
+static constexpr auto defaultFramesPerSecond = 30;
+static constexpr auto maxFramesPerSecond = 120;
+static constexpr auto defaultBufferSize = 8;
+static constexpr auto maxBufferSize = 256;
+static constexpr auto encoderPollIntervalMs = 100;
+
+[[nodiscard]] static int getIntArgument (const Command & command,
+                                         const juce::String & argument,
+                                         int defaultValue,
+                                         int maxValue)
+{
+    const auto value = command.getArgumentAsVar (argument);
+    return value.isVoid () ? defaultValue : juce::jlimit (1, maxValue, int (value));
+}
+
+FrameCapture::FrameCapture (TestCentre & testCentre)
+    : juce::Thread ("Frame capture encoder")
+    , _testCentre (testCentre)
+{
+}
+
+FrameCapture::~FrameCapture ()
+{
+    stopTimer ();
+    _sendRemainingFrames = false;
+
+    static constexpr auto waitForever = -1;
+    stopThread (waitForever);
+}
+
+std::optional<Response> FrameCapture::process (const Command & command)
+{
+    if (command.getType () == "start-capture")
+        return start (command);
+
+    if (command.getType () == "stop-capture")
+        return stop ();
+
+    return std::nullopt;
+}
+
+Response FrameCapture::start (const Command & command)
+{
+    if (_capturing)
+        return Response::fail ("Capture already running");
+
+    const auto componentId = command.getArgument ("component-id");
+    const auto windowId = command.getArgument ("window-id");
+
+    auto * component = componentId.isEmpty () ? ComponentSearch::findWindowWithId (windowId)
+                                              : ComponentSearch::findWithId (componentId);
+
+    if (component == nullptr)
+        return Response::fail ("Component not found: " + componentId);
+
+    if (component->getLocalBounds ().isEmpty ())
+        return Response::fail ("Component has no area: " + componentId);
+
+    const auto framesPerSecond =
+        getIntArgument (command, "fps", defaultFramesPerSecond, maxFramesPerSecond);
+    const auto bufferSize =
+        getIntArgument (command, "buffer-size", defaultBufferSize, maxBufferSize);
+
+    // The previous capture's last frames have normally been sent by the time a new one starts
+    static constexpr auto waitForever = -1;
+    stopThread (waitForever);
+
+    _frames.clear ();
+    _frames.resize (static_cast<size_t> (bufferSize));
+
+    for (auto & frame : _frames)
+        frame.image =
+            juce::Image (juce::Image::ARGB, component->getWidth (), component->getHeight (), true);
+
+    _fifo.setTotalSize (bufferSize + 1);
+
+    ++_captureId;
+    _numCaptured = 0;
+    _numDropped = 0;
+    _numMissed = 0;
+    _frameInterval = 1000.0 / framesPerSecond;
+    _startTime = juce::Time::getMillisecondCounterHiRes ();
+    _lastTickTime = _startTime;
+    _component = component;
+    _capturing = true;
+    _sendRemainingFrames = true;
+
+    startThread ();
+    startTimerHz (framesPerSecond);
+
+    return Response::ok ()
+        .withParameter ("capture-id", _captureId)
+        .withParameter ("width", component->getWidth ())
+        .withParameter ("height", component->getHeight ());
+}
+
+// Responds straight away, leaving the encoder thread to send the frames it hasn't sent yet
+Response FrameCapture::stop ()
+{
+    if (! _capturing)
+        return Response::fail ("No capture running");
+
+    stopTimer ();
+    signalThreadShouldExit ();
+    notify ();
+
+    _capturing = false;
+    _component = nullptr;
+
+    return Response::ok ()
+        .withParameter ("capture-id", _captureId)
+        .withParameter ("captured", _numCaptured)
+        .withParameter ("dropped", _numDropped)
+        .withParameter ("missed", _numMissed);
+}
+
+void FrameCapture::timerCallback ()
+{
+    if (_component == nullptr)
+    {
+        stopTimer ();
+        return;
+    }
+
+    const auto now = juce::Time::getMillisecondCounterHiRes ();
+    _numMissed += std::max (0, juce::roundToInt ((now - _lastTickTime) / _frameInterval) - 1);
+    _lastTickTime = now;
+
+    if (_fifo.getFreeSpace () == 0)
+    {
+        ++_numDropped;
+        return;
+    }
+
+    captureFrame (*_component, now);
+    notify ();
+}
+
+void FrameCapture::captureFrame (juce::Component & component, double now)
+{
+    const auto scope = _fifo.write (1);
+    auto & frame = _frames [static_cast<size_t> (scope.startIndex1)];
+
+    frame.image.clear (frame.image.getBounds ());
+
+    {
+        juce::Graphics graphics (frame.image);
+        component.paintEntireComponent (graphics, true);
+    }
+
+    frame.timestamp = now - _startTime;
+    frame.index = _numCaptured++;
+}
+
+void FrameCapture::run ()
+{
+    const AllocationTracker::ScopedOwner owner (AllocationTracker::Owner::library);
+
+    while (! threadShouldExit ())
+    {
+        wait (encoderPollIntervalMs);
+        encodeAvailableFrames ();
+    }
+
+    if (_sendRemainingFrames)
+        encodeAvailableFrames ();
+}
+
+void FrameCapture::encodeAvailableFrames ()
+{
+    while (_fifo.getNumReady () > 0)
+    {
+        const auto scope = _fifo.read (1);
+        const auto & frame = _frames [static_cast<size_t> (scope.startIndex1)];
+
+        _testCentre.sendEvent (Event ("capture-frame")
+                                   .withParameter ("capture-id", _captureId)
+                                   .withParameter ("index", frame.index)
+                                   .withParameter ("timestamp", frame.timestamp)
+                                   .withParameter ("image", encodeImageAsBase64Png (frame.image)));
+    }
+}
+
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <focusrite/e2e/CommandHandler.h>
+#include <juce_gui_basics/juce_gui_basics.h>
+
+namespace focusrite::e2e
+{
+class TestCentre;
+
+class FrameCapture final
+    : public CommandHandler
+    , private juce::Timer
+    , private juce::Thread
+{
+public:
+    explicit FrameCapture (TestCentre & testCentre);
+    ~FrameCapture () override;
+
+    FrameCapture (const FrameCapture &) = delete;
+    FrameCapture & operator= (const FrameCapture &) = delete;
+
+    std::optional<Response> process (const Command & command) override;
+
+private:
+    struct Frame
+    {
+        juce::Image image;
+        double timestamp = 0.0;
+        int index = 0;
+    };
+
+    [[nodiscard]] Response start (const Command & command);
+    [[nodiscard]] Response stop ();
+
+    void timerCallback () override;
+    void run () override;
+
+    void captureFrame (juce::Component & component, double now);
+    void encodeAvailableFrames ();
+
+    TestCentre & _testCentre;
+    juce::Component::SafePointer<juce::Component> _component;
+    std::vector<Frame> _frames;
+    juce::AbstractFifo _fifo {1};
+
+    bool _capturing = false;
+    std::atomic<bool> _sendRemainingFrames {false};
+
+    int _captureId = 0;
+    int _numCaptured = 0;
+    int _numDropped = 0;
+    int _numMissed = 0;
+    double _frameInterval = 0.0;
+    double _startTime = 0.0;
+    double _lastTickTime = 0.0;
+};
+
+}
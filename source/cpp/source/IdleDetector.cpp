@@ -0,0 +1,257 @@
+#include "IdleDetector.h"
+
+namespace focusrite::e2e
+{
+static constexpr auto defaultQuietMs = 100;
+static constexpr auto maxQuietMs = 60'000;
+static constexpr auto defaultTimeoutMs = 5'000;
+static constexpr auto maxTimeoutMs = 120'000;
+
+// A probe that waits longer than this behind other messages means the message thread was busy
+static constexpr auto busyThresholdMs = 2.0;
+static constexpr auto probeIntervalMs = 2;
+
+[[nodiscard]] static int getIntArgument (const Command & command,
+                                         const juce::String & argument,
+                                         int defaultValue,
+                                         int maxValue)
+{
+    const auto value = command.getArgumentAsVar (argument);
+    return value.isVoid () ? defaultValue : juce::jlimit (0, maxValue, int (value));
+}
+
+// Installed on top-level windows to see repaint requests from any component inside them. Windows
+// are painted by their peer rather than through the cached image, so painting is unaffected.
+class IdleDetector::RepaintHook final : public juce::CachedComponentImage
+{
+public:
+    RepaintHook (juce::Component & window, IdleDetector & detector)
+        : _window (window)
+        , _detector (detector)
+    {
+    }
+
+    void paint (juce::Graphics & graphics) override
+    {
+        _window.paintEntireComponent (graphics, false);
+    }
+
+    bool invalidateAll () override
+    {
+        _detector.onRepaintRequested ();
+        return true;
+    }
+
+    bool invalidate (const juce::Rectangle<int> & area) override
+    {
+        juce::ignoreUnused (area);
+
+        _detector.onRepaintRequested ();
+        return true;
+    }
+
+    void releaseResources () override
+    {
+    }
+
+private:
+    juce::Component & _window;
+    IdleDetector & _detector;
+};
+
+class IdleDetector::Wait final : public std::enable_shared_from_this<Wait>
+{
+public:
+    Wait (const IdleDetector & detector,
+          int quietMs,
+          int timeoutMs,
+          std::shared_ptr<Responder> responder)
+        : _detector (detector)
+        , _quietMs (quietMs)
+        , _timeoutMs (timeoutMs)
+        , _responder (std::move (responder))
+        , _startMs (juce::Time::getMillisecondCounterHiRes ())
+        , _lastActivityMs (_startMs)
+        , _firstRepaintRequest (detector._numRepaintRequests)
+    {
+    }
+
+    // Called every few milliseconds; a probe still waiting in the queue isn't posted again, so the
+    // message thread is left alone between probes
+    void postProbe ()
+    {
+        if (_probePending)
+            return;
+
+        _probePending = juce::MessageManager::callAsync (
+            [weakWait = weak_from_this (), postedMs = juce::Time::getMillisecondCounterHiRes ()]
+            {
+                if (auto wait = weakWait.lock ())
+                    wait->onProbe (postedMs);
+            });
+    }
+
+    [[nodiscard]] bool isFinished () const
+    {
+        return _responder->hasResponded ();
+    }
+
+private:
+    void onProbe (double postedMs)
+    {
+        _probePending = false;
+
+        if (isFinished ())
+            return;
+
+        const auto nowMs = juce::Time::getMillisecondCounterHiRes ();
+
+        if (nowMs - postedMs > busyThresholdMs)
+        {
+            _lastActivityMs = nowMs;
+            _lastActivity = "message";
+            ++_numBusyProbes;
+        }
+
+        if (_detector._lastRepaintRequestMs > _lastActivityMs)
+        {
+            _lastActivityMs = _detector._lastRepaintRequestMs;
+            _lastActivity = "repaint";
+        }
+
+        const auto waitedMs = nowMs - _startMs;
+
+        if (nowMs - _lastActivityMs >= _quietMs)
+        {
+            _responder->respond (withStats (Response::ok (), waitedMs));
+            return;
+        }
+
+        if (waitedMs >= _timeoutMs)
+        {
+            _responder->respond (
+                withStats (Response::fail ("Timed out waiting for idle"), waitedMs)
+                    .withParameter ("last-activity", _lastActivity));
+        }
+    }
+
+    [[nodiscard]] Response withStats (const Response & response, double waitedMs) const
+    {
+        return response.withParameter ("waited-ms", waitedMs)
+            .withParameter ("quiet-ms", _quietMs)
+            .withParameter ("busy-probes", _numBusyProbes)
+            .withParameter ("repaint-requests",
+                            _detector._numRepaintRequests - _firstRepaintRequest);
+    }
+
+    const IdleDetector & _detector;
+    const int _quietMs;
+    const int _timeoutMs;
+    const std::shared_ptr<Responder> _responder;
+    const double _startMs;
+    double _lastActivityMs;
+    juce::String _lastActivity;
+    const int _firstRepaintRequest;
+    int _numBusyProbes = 0;
+    bool _probePending = false;
+};
+
+IdleDetector::IdleDetector () = default;
+
+IdleDetector::~IdleDetector ()
+{
+    stopTimer ();
+    removeRepaintHooks ();
+}
+
+bool IdleDetector::process (const Command & command, std::shared_ptr<Responder> responder)
+{
+    if (command.getType () != "wait-for-idle")
+        return false;
+
+    removeFinishedWaits ();
+    installRepaintHooks ();
+
+    const auto quietMs = getIntArgument (command, "quiet-ms", defaultQuietMs, maxQuietMs);
+    const auto timeoutMs = getIntArgument (command, "timeout-ms", defaultTimeoutMs, maxTimeoutMs);
+
+    auto & wait =
+        *_waits.emplace_back (std::make_shared<Wait> (*this, quietMs, timeoutMs, responder));
+    wait.postProbe ();
+
+    if (! isTimerRunning ())
+        startTimer (probeIntervalMs);
+
+    return true;
+}
+
+juce::RelativeTime IdleDetector::getTimeout (const Command & command) const
+{
+    return AsyncCommandHandler::getTimeout (command) +
+           juce::RelativeTime::milliseconds (
+               getIntArgument (command, "timeout-ms", defaultTimeoutMs, maxTimeoutMs));
+}
+
+void IdleDetector::timerCallback ()
+{
+    removeFinishedWaits ();
+
+    if (_waits.empty ())
+    {
+        stopTimer ();
+        removeRepaintHooks ();
+        return;
+    }
+
+    for (auto & wait : _waits)
+        wait->postProbe ();
+}
+
+void IdleDetector::removeFinishedWaits ()
+{
+    _waits.erase (std::remove_if (_waits.begin (),
+                                  _waits.end (),
+                                  [] (auto && wait) { return wait->isFinished (); }),
+                  _waits.end ());
+}
+
+// Windows that already have a cached image, such as those with an OpenGL context attached, are
+// left alone
+void IdleDetector::installRepaintHooks ()
+{
+    _hookedWindows.erase (std::remove_if (_hookedWindows.begin (),
+                                          _hookedWindows.end (),
+                                          [] (auto && window) { return window == nullptr; }),
+                          _hookedWindows.end ());
+
+    auto & desktop = juce::Desktop::getInstance ();
+
+    for (int index = 0; index < desktop.getNumComponents (); ++index)
+    {
+        auto * window = desktop.getComponent (index);
+
+        if (window == nullptr || window->getCachedComponentImage () != nullptr)
+            continue;
+
+        window->setCachedComponentImage (new RepaintHook (*window, *this));
+        _hookedWindows.emplace_back (window);
+    }
+}
+
+void IdleDetector::removeRepaintHooks ()
+{
+    for (auto & window : _hookedWindows)
+        if (window != nullptr &&
+            dynamic_cast<RepaintHook *> (window->getCachedComponentImage ()) != nullptr)
+            window->setCachedComponentImage (nullptr);
+
+    _hookedWindows.clear ();
+}
+
+void IdleDetector::onRepaintRequested ()
+{
+    _lastRepaintRequestMs = juce::Time::getMillisecondCounterHiRes ();
+    ++_numRepaintRequests;
+}
+
+}
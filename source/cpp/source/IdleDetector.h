@@ -0,0 +1,43 @@
+#pragma once
+
+#include <focusrite/e2e/AsyncCommandHandler.h>
+#include <juce_gui_basics/juce_gui_basics.h>
+
+namespace focusrite::e2e
+{
+// Handles wait-for-idle: responds once the message thread has been quiet for a given period,
+// meaning no window has requested a repaint and the probe messages posted to the message queue
+// every few milliseconds have run without waiting behind other work, such as timer and async
+// update callbacks
+class IdleDetector final
+    : public AsyncCommandHandler
+    , private juce::Timer
+{
+public:
+    IdleDetector ();
+    ~IdleDetector () override;
+
+    IdleDetector (const IdleDetector &) = delete;
+    IdleDetector & operator= (const IdleDetector &) = delete;
+
+    bool process (const Command & command, std::shared_ptr<Responder> responder) override;
+    [[nodiscard]] juce::RelativeTime getTimeout (const Command & command) const override;
+
+private:
+    class RepaintHook;
+    class Wait;
+
+    void timerCallback () override;
+
+    void removeFinishedWaits ();
+    void installRepaintHooks ();
+    void removeRepaintHooks ();
+    void onRepaintRequested ();
+
+    std::vector<std::shared_ptr<Wait>> _waits;
+    std::vector<juce::Component::SafePointer<juce::Component>> _hookedWindows;
+    double _lastRepaintRequestMs = 0.0;
+    int _numRepaintRequests = 0;
+};
+
+}
@@ -106,4 +106,24 @@ juce::KeyPress constructKeyPress (const juce::String & code, const juce::String
     return {mapKeyCode (code), mapModifierKeys (modifiers), 0};
 }
 
+juce::ModifierKeys constructModifierKeys (const juce::String & modifiers)
+{
+    return mapModifierKeys (modifiers);
+}
+
+juce::KeyPress constructKeyPress (juce::juce_wchar character)
+{
+    if (character == '\n' || character == '\r')
+        return {juce::KeyPress::returnKey, juce::ModifierKeys::noModifiers, character};
+
+    if (character == '\t')
+        return {juce::KeyPress::tabKey, juce::ModifierKeys::noModifiers, character};
+
+    const auto modifiers = juce::CharacterFunctions::isUpperCase (character)
+                               ? juce::ModifierKeys::shiftModifier
+                               : juce::ModifierKeys::noModifiers;
+
+    return {int (character), modifiers, character};
+}
+
 }
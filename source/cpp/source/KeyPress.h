@@ -6,4 +6,6 @@
 namespace focusrite::e2e
 {
 juce::KeyPress constructKeyPress (const juce::String & code, const juce::String & modifiers);
+juce::KeyPress constructKeyPress (juce::juce_wchar character);
+juce::ModifierKeys constructModifierKeys (const juce::String & modifiers);
 }
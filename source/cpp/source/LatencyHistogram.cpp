@@ -0,0 +1,116 @@
+#include "LatencyHistogram.h"
+
+namespace focusrite::e2e
+{
+[[nodiscard]] static int getMagnitude (uint64_t value) noexcept
+{
+    auto magnitude = 0;
+
+    while (value >>= 1)
+        ++magnitude;
+
+    return magnitude;
+}
+
+LatencyHistogram::LatencyHistogram ()
+{
+    reset ();
+}
+
+int LatencyHistogram::getBucketIndex (uint64_t value) noexcept
+{
+    if (value < uint64_t (subBucketCount))
+        return int (value);
+
+    const auto magnitude = std::min (getMagnitude (value), maxMagnitude);
+    const auto shift = magnitude - subBucketBits;
+    const auto subBucket = std::min (int (value >> shift), 2 * subBucketCount - 1);
+
+    return (shift + 1) * subBucketCount + subBucket - subBucketCount;
+}
+
+uint64_t LatencyHistogram::getBucketUpperBound (int index) noexcept
+{
+    if (index < subBucketCount)
+        return uint64_t (index);
+
+    const auto shift = index / subBucketCount - 1;
+    const auto subBucket = uint64_t (index % subBucketCount + subBucketCount);
+
+    return ((subBucket + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record (uint64_t microseconds) noexcept
+{
+    _buckets [static_cast<size_t> (getBucketIndex (microseconds))].fetch_add (
+        1, std::memory_order_relaxed);
+    _count.fetch_add (1, std::memory_order_relaxed);
+    _sum.fetch_add (microseconds, std::memory_order_relaxed);
+
+    auto max = _max.load (std::memory_order_relaxed);
+    while (max < microseconds &&
+           ! _max.compare_exchange_weak (max, microseconds, std::memory_order_relaxed))
+    {
+    }
+}
+
+void LatencyHistogram::reset () noexcept
+{
+    for (auto & bucket : _buckets)
+        bucket.store (0, std::memory_order_relaxed);
+
+    _count.store (0, std::memory_order_relaxed);
+    _sum.store (0, std::memory_order_relaxed);
+    _max.store (0, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::getCount () const noexcept
+{
+    return _count.load (std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::getMax () const noexcept
+{
+    return _max.load (std::memory_order_relaxed);
+}
+
+double LatencyHistogram::getMean () const noexcept
+{
+    const auto count = getCount ();
+    return count == 0 ? 0.0 : double (_sum.load (std::memory_order_relaxed)) / double (count);
+}
+
+uint64_t LatencyHistogram::getPercentile (double percentile) const noexcept
+{
+    const auto count = getCount ();
+    if (count == 0)
+        return 0;
+
+    const auto target =
+        std::max (uint64_t (1), uint64_t (std::ceil (percentile / 100.0 * double (count))));
+    uint64_t seen = 0;
+
+    for (auto index = 0; index < numBuckets; ++index)
+    {
+        seen += _buckets [static_cast<size_t> (index)].load (std::memory_order_relaxed);
+
+        if (seen >= target)
+            return std::min (getBucketUpperBound (index), getMax ());
+    }
+
+    return getMax ();
+}
+
+juce::var LatencyHistogram::toVar () const
+{
+    auto summary = std::make_unique<juce::DynamicObject> ();
+    summary->setProperty ("count", juce::int64 (getCount ()));
+    summary->setProperty ("mean", getMean ());
+    summary->setProperty ("p50", juce::int64 (getPercentile (50.0)));
+    summary->setProperty ("p90", juce::int64 (getPercentile (90.0)));
+    summary->setProperty ("p99", juce::int64 (getPercentile (99.0)));
+    summary->setProperty ("max", juce::int64 (getMax ()));
+    return summary.release ();
+}
+
+}
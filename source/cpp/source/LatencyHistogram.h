@@ -0,0 +1,41 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
+
+namespace focusrite::e2e
+{
+class LatencyHistogram
+{
+public:
+    LatencyHistogram ();
+
+    void record (uint64_t microseconds) noexcept;
+    void reset () noexcept;
+
+    [[nodiscard]] uint64_t getCount () const noexcept;
+    [[nodiscard]] uint64_t getMax () const noexcept;
+    [[nodiscard]] double getMean () const noexcept;
+    [[nodiscard]] uint64_t getPercentile (double percentile) const noexcept;
+
+    [[nodiscard]] juce::var toVar () const;
+
+    // Values are bucketed with 4 significant bits after the leading one, giving at most ~6%
+    // relative error, and are exact below 32
+    static constexpr int subBucketBits = 4;
+    static constexpr int subBucketCount = 1 << subBucketBits;
+    static constexpr int maxMagnitude = 39;
+    static constexpr int numBuckets = subBucketCount * (maxMagnitude - subBucketBits + 2);
+
+    [[nodiscard]] static int getBucketIndex (uint64_t value) noexcept;
+    [[nodiscard]] static uint64_t getBucketUpperBound (int index) noexcept;
+
+private:
+    std::array<std::atomic<uint64_t>, numBuckets> _buckets;
+    std::atomic<uint64_t> _count {0};
+    std::atomic<uint64_t> _sum {0};
+    std::atomic<uint64_t> _max {0};
+};
+
+}
@@ -0,0 +1,105 @@
+#include "MemoryStats.h"
+
+#include "AllocationTracker.h"
+#include "ProcFile.h"
+
+namespace focusrite::e2e
+{
+static constexpr auto bytesPerKilobyte = 1024;
+
+// Parses "Name:   1234 kB"
+[[nodiscard]] static std::optional<std::pair<juce::String, juce::int64>>
+parseSize (const juce::String & line)
+{
+    const auto name = line.upToFirstOccurrenceOf (":", false, false).trim ();
+    const auto value = line.fromFirstOccurrenceOf (":", false, false).trim ();
+
+    if (name.isEmpty () || ! value.endsWith (" kB"))
+        return std::nullopt;
+
+    return std::make_pair (name, value.getLargeIntValue ());
+}
+
+std::optional<Response> MemoryStats::process (const Command & command)
+{
+    if (command.getType () != "get-memory-stats")
+        return std::nullopt;
+
+#if JUCE_LINUX
+    const auto status = parseStatus (readProcFile ("/proc/self/status"));
+    const auto heap = parseHeap (readProcFile ("/proc/self/smaps"));
+
+    const auto getBytes = [] (const auto & sizes, const char * name) -> juce::var
+    {
+        const auto it = sizes.find (name);
+        return it == sizes.end () ? juce::var () : juce::var (it->second * bytesPerKilobyte);
+    };
+
+    auto response = Response::ok ()
+                        .withParameter ("rss-bytes", getBytes (status, "VmRSS"))
+                        .withParameter ("peak-rss-bytes", getBytes (status, "VmHWM"))
+                        .withParameter ("virtual-bytes", getBytes (status, "VmSize"))
+                        .withParameter ("data-bytes", getBytes (status, "VmData"))
+                        .withParameter ("heap-size-bytes", getBytes (heap, "Size"))
+                        .withParameter ("heap-rss-bytes", getBytes (heap, "Rss"));
+
+    if (AllocationTracker::isAvailable ())
+    {
+        using Owner = AllocationTracker::Owner;
+
+        const auto app = AllocationTracker::getProcessCounts (Owner::app);
+        const auto library = AllocationTracker::getProcessCounts (Owner::library);
+
+        response.addParameter ("allocations", juce::int64 (app.allocations + library.allocations));
+        response.addParameter ("frees", juce::int64 (AllocationTracker::getProcessFrees ()));
+    }
+
+    return response;
+#else
+    return Response::fail ("Memory stats are only available on Linux");
+#endif
+}
+
+CommandHandler::ThreadAffinity MemoryStats::getThreadAffinity (const Command & command) const
+{
+    juce::ignoreUnused (command);
+    return ThreadAffinity::anyThread;
+}
+
+std::map<juce::String, juce::int64> MemoryStats::parseStatus (const juce::String & text)
+{
+    std::map<juce::String, juce::int64> sizes;
+
+    for (const auto & line : juce::StringArray::fromLines (text))
+        if (const auto size = parseSize (line))
+            sizes.insert (*size);
+
+    return sizes;
+}
+
+std::map<juce::String, juce::int64> MemoryStats::parseHeap (const juce::String & text)
+{
+    std::map<juce::String, juce::int64> sizes;
+    auto inHeap = false;
+
+    for (const auto & line : juce::StringArray::fromLines (text))
+    {
+        // Each mapping starts with its address range, such as "55d0c3a2e000-55d0c3a4f000 rw-p"
+        if (const auto range = line.upToFirstOccurrenceOf (" ", false, false);
+            range.containsChar ('-') && range.containsOnly ("0123456789abcdef-"))
+        {
+            if (inHeap)
+                break;
+
+            inHeap = line.trimEnd ().endsWith ("[heap]");
+            continue;
+        }
+
+        if (const auto size = parseSize (line); inHeap && size)
+            sizes.insert (*size);
+    }
+
+    return sizes;
+}
+
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <focusrite/e2e/CommandHandler.h>
+#include <map>
+
+namespace focusrite::e2e
+{
+// Handles get-memory-stats: the process's resident and virtual memory and its heap, read from
+// /proc/self on Linux
+class MemoryStats final : public CommandHandler
+{
+public:
+    std::optional<Response> process (const Command & command) override;
+    [[nodiscard]] ThreadAffinity getThreadAffinity (const Command & command) const override;
+
+    // Returns the sizes in kB from /proc/self/status-style text, such as "VmRSS:  1024 kB"
+    [[nodiscard]] static std::map<juce::String, juce::int64>
+    parseStatus (const juce::String & text);
+
+    // Returns the Size and Rss in kB of the [heap] mapping in /proc/self/smaps-style text
+    [[nodiscard]] static std::map<juce::String, juce::int64>
+    parseHeap (const juce::String & text);
+};
+
+}
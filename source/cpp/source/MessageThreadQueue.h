@@ -0,0 +1,131 @@
+#pragma once
+
+#include <deque>
+#include <juce_events/juce_events.h>
+#include <optional>
+
+namespace focusrite::e2e
+{
+// Hands items from any thread to a callback on the message thread, in the order they were
+// posted. One message is posted for however many items are waiting, and the same message is
+// posted every time, so unlike MessageManager::callAsync, posting an item doesn't allocate. If the
+// message thread falls more than the capacity behind, items go to an overflow list, which does
+// allocate, until it has drained.
+template <typename Item>
+class MessageThreadQueue
+{
+public:
+    using Callback = std::function<void (Item &)>;
+
+    MessageThreadQueue (int capacity, Callback callback)
+        : _fifo (capacity)
+        , _items (size_t (capacity))
+        , _callback (std::move (callback))
+        , _message (new Message (*this))
+    {
+    }
+
+    ~MessageThreadQueue ()
+    {
+        _message->detach ();
+    }
+
+    MessageThreadQueue (const MessageThreadQueue &) = delete;
+    MessageThreadQueue & operator= (const MessageThreadQueue &) = delete;
+
+    void post (Item item)
+    {
+        {
+            const juce::SpinLock::ScopedLockType lock (_writeLock);
+
+            // Once anything has overflowed, later items follow it so that none overtakes another
+            if (! _overflow.empty () || ! write (item))
+                _overflow.push_back (std::move (item));
+        }
+
+        if (! _posted.exchange (true) && ! _message->post ())
+            _posted = false;
+    }
+
+private:
+    // Outlives the queue if it's still waiting to be delivered when the queue is destroyed
+    class Message final : public juce::MessageManager::MessageBase
+    {
+    public:
+        explicit Message (MessageThreadQueue & queue)
+            : _queue (&queue)
+        {
+        }
+
+        void messageCallback () override
+        {
+            const juce::ScopedLock lock (_lock);
+
+            if (_queue != nullptr)
+                _queue->deliver ();
+        }
+
+        void detach ()
+        {
+            const juce::ScopedLock lock (_lock);
+            _queue = nullptr;
+        }
+
+    private:
+        juce::CriticalSection _lock;
+        MessageThreadQueue * _queue;
+    };
+
+    [[nodiscard]] bool write (Item & item)
+    {
+        const auto scope = _fifo.write (1);
+        if (scope.blockSize1 == 0)
+            return false;
+
+        _items [size_t (scope.startIndex1)].emplace (std::move (item));
+        return true;
+    }
+
+    // Anything in the overflow list was posted after everything in the fifo
+    [[nodiscard]] std::optional<Item> read ()
+    {
+        std::optional<Item> item;
+
+        if (const auto scope = _fifo.read (1); scope.blockSize1 != 0)
+        {
+            auto & slot = _items [size_t (scope.startIndex1)];
+            item = std::move (slot);
+            slot.reset ();
+            return item;
+        }
+
+        const juce::SpinLock::ScopedLockType lock (_writeLock);
+
+        if (! _overflow.empty ())
+        {
+            item = std::move (_overflow.front ());
+            _overflow.pop_front ();
+        }
+
+        return item;
+    }
+
+    void deliver ()
+    {
+        // Cleared first so that an item posted while delivering posts the message again
+        _posted = false;
+
+        while (auto item = read ())
+            _callback (*item);
+    }
+
+    juce::AbstractFifo _fifo;
+    std::vector<std::optional<Item>> _items;
+    juce::SpinLock _writeLock;
+    std::deque<Item> _overflow;
+    std::atomic<bool> _posted {false};
+    const Callback _callback;
+    const juce::ReferenceCountedObjectPtr<Message> _message;
+};
+
+}
@@ -0,0 +1,242 @@
+#include "MouseGesture.h"
+
+#include "AllocationTracker.h"
+#include "KeyPress.h"
+
+#include <focusrite/e2e/ComponentSearch.h>
+#include <optional>
+
+namespace focusrite::e2e
+{
+static constexpr auto defaultStepMs = 10.0;
+static constexpr auto timerIntervalMs = 5;
+
+[[nodiscard]] static juce::ModifierKeys getModifiers (const juce::var & point)
+{
+    const auto buttons = point.getProperty ("buttons", {}).toString ();
+    const auto modifiers = point.getProperty ("modifiers", {}).toString ();
+    auto flags = constructModifierKeys (modifiers).getRawFlags ();
+
+    if (buttons.contains ("left"))
+        flags |= juce::ModifierKeys::leftButtonModifier;
+    if (buttons.contains ("right"))
+        flags |= juce::ModifierKeys::rightButtonModifier;
+    if (buttons.contains ("middle"))
+        flags |= juce::ModifierKeys::middleButtonModifier;
+
+    return juce::ModifierKeys (flags);
+}
+
+[[nodiscard]] static double getLastTimeMs (const Command & command)
+{
+    const auto points = command.getArgumentAsVar ("points");
+    if (! points.isArray () || points.size () == 0)
+        return 0.0;
+
+    return points [points.size () - 1].getProperty ("time-ms", 0.0);
+}
+
+juce::Result MouseGesture::createSamples (const Command & command, std::vector<Sample> & samples)
+{
+    const auto points = command.getArgumentAsVar ("points");
+    if (! points.isArray () || points.size () == 0)
+        return juce::Result::fail ("Missing points");
+
+    const auto stepArgument = command.getArgumentAsVar ("step-ms");
+    const auto stepMs =
+        stepArgument.isVoid () ? defaultStepMs : juce::jlimit (1.0, 1000.0, double (stepArgument));
+
+    samples.clear ();
+    std::optional<Sample> previous;
+
+    for (const auto & point : *points.getArray ())
+    {
+        Sample sample;
+        sample.timeMs = point.getProperty ("time-ms", previous ? previous->timeMs : 0.0);
+        sample.position = {float (point.getProperty ("x", 0.0)),
+                           float (point.getProperty ("y", 0.0))};
+        sample.modifiers = getModifiers (point);
+        sample.wheelDelta = {float (point.getProperty ("wheel-x", 0.0)),
+                             float (point.getProperty ("wheel-y", 0.0))};
+
+        if (previous)
+        {
+            if (sample.timeMs < previous->timeMs)
+                return juce::Result::fail ("Points must be in time order");
+
+            // Buttons and modifiers change at the points; in between, only the position moves
+            const auto durationMs = sample.timeMs - previous->timeMs;
+
+            for (auto timeMs = previous->timeMs + stepMs; timeMs < sample.timeMs; timeMs += stepMs)
+            {
+                const auto proportion = float ((timeMs - previous->timeMs) / durationMs);
+                samples.push_back ({timeMs,
+                                    previous->position +
+                                        (sample.position - previous->position) * proportion,
+                                    previous->modifiers,
+                                    {}});
+            }
+        }
+
+        samples.push_back (sample);
+        previous = sample;
+    }
+
+    return juce::Result::ok ();
+}
+
+class MouseGesture::Playback final : private juce::Timer
+{
+public:
+    Playback (juce::Component & target,
+              std::vector<Sample> samples,
+              bool instant,
+              std::shared_ptr<Responder> responder)
+        : _target (&target)
+        , _samples (std::move (samples))
+        , _instant (instant)
+        , _responder (std::move (responder))
+        , _startMs (juce::Time::getMillisecondCounterHiRes ())
+        , _startTime (juce::Time::currentTimeMillis ())
+    {
+    }
+
+    void start ()
+    {
+        // Instant gestures are dispatched in one go, with event times spaced as in the path
+        dispatchDue (_instant ? std::numeric_limits<double>::infinity () : 0.0);
+
+        if (! isFinished ())
+            startTimer (timerIntervalMs);
+    }
+
+    [[nodiscard]] bool isFinished () const
+    {
+        return _responder->hasResponded ();
+    }
+
+private:
+    void timerCallback () override
+    {
+        dispatchDue (juce::Time::getMillisecondCounterHiRes () - _startMs);
+
+        if (isFinished ())
+            stopTimer ();
+    }
+
+    void dispatchDue (double elapsedMs)
+    {
+        while (_numDispatched < _samples.size () && _samples [_numDispatched].timeMs <= elapsedMs)
+        {
+            if (! dispatch (_samples [_numDispatched]))
+                return;
+
+            ++_numDispatched;
+        }
+
+        if (_numDispatched == _samples.size ())
+            _responder->respond (
+                Response::ok ()
+                    .withParameter ("events", int (_numDispatched))
+                    .withParameter ("duration-ms",
+                                    juce::Time::getMillisecondCounterHiRes () - _startMs));
+    }
+
+    bool dispatch (const Sample & sample)
+    {
+        if (_target == nullptr)
+        {
+            _responder->respond (Response::fail ("Component deleted during gesture"));
+            return false;
+        }
+
+        auto * peer = _target->getPeer ();
+        if (peer == nullptr)
+        {
+            _responder->respond (Response::fail ("Component isn't on the desktop"));
+            return false;
+        }
+
+        const auto position =
+            peer->getComponent ().getLocalPoint (_target.getComponent (), sample.position);
+        const auto time = _instant ? _startTime + juce::int64 (sample.timeMs)
+                                   : juce::Time::currentTimeMillis ();
+
+        const AllocationTracker::ScopedOwner owner (AllocationTracker::Owner::app);
+
+        peer->handleMouseEvent (juce::MouseInputSource::InputSourceType::mouse,
+                                position,
+                                sample.modifiers,
+                                juce::MouseInputSource::defaultPressure,
+                                juce::MouseInputSource::defaultOrientation,
+                                time);
+
+        if (! sample.wheelDelta.isOrigin ())
+        {
+            juce::MouseWheelDetails wheel {};
+            wheel.deltaX = sample.wheelDelta.x;
+            wheel.deltaY = sample.wheelDelta.y;
+
+            peer->handleMouseWheel (
+                juce::MouseInputSource::InputSourceType::mouse, position, time, wheel);
+        }
+
+        return true;
+    }
+
+    juce::Component::SafePointer<juce::Component> _target;
+    const std::vector<Sample> _samples;
+    const bool _instant;
+    const std::shared_ptr<Responder> _responder;
+    const double _startMs;
+    const juce::int64 _startTime;
+    size_t _numDispatched = 0;
+};
+
+MouseGesture::MouseGesture () = default;
+MouseGesture::~MouseGesture () = default;
+
+bool MouseGesture::process (const Command & command, std::shared_ptr<Responder> responder)
+{
+    if (command.getType () != "mouse-gesture")
+        return false;
+
+    _playbacks.erase (std::remove_if (_playbacks.begin (),
+                                      _playbacks.end (),
+                                      [] (auto && playback) { return playback->isFinished (); }),
+                      _playbacks.end ());
+
+    const auto componentId = command.getArgument ("component-id");
+    auto * target = componentId.isEmpty ()
+                        ? ComponentSearch::findWindowWithId (command.getArgument ("window-id"))
+                        : ComponentSearch::findWithId (componentId);
+
+    if (target == nullptr)
+    {
+        responder->respond (Response::fail ("Component not found for gesture: " + componentId));
+        return true;
+    }
+
+    std::vector<Sample> samples;
+    if (const auto result = createSamples (command, samples); result.failed ())
+    {
+        responder->respond (Response::fail (result.getErrorMessage ()));
+        return true;
+    }
+
+    const auto instant = bool (command.getArgumentAsVar ("instant"));
+
+    auto & playback = *_playbacks.emplace_back (
+        std::make_unique<Playback> (*target, std::move (samples), instant, responder));
+    playback.start ();
+
+    return true;
+}
+
+juce::RelativeTime MouseGesture::getTimeout (const Command & command) const
+{
+    return AsyncCommandHandler::getTimeout (command) +
+           juce::RelativeTime::milliseconds (juce::int64 (getLastTimeMs (command)));
+}
+
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <focusrite/e2e/AsyncCommandHandler.h>
+#include <juce_gui_basics/juce_gui_basics.h>
+
+namespace focusrite::e2e
+{
+// Handles mouse-gesture: plays a timed path of points relative to a component as real mouse
+// events through the component's peer, interpolating between the points, so drags, paths and
+// wheel movements take a single command
+class MouseGesture final : public AsyncCommandHandler
+{
+public:
+    MouseGesture ();
+    ~MouseGesture () override;
+
+    MouseGesture (const MouseGesture &) = delete;
+    MouseGesture & operator= (const MouseGesture &) = delete;
+
+    bool process (const Command & command, std::shared_ptr<Responder> responder) override;
+    [[nodiscard]] juce::RelativeTime getTimeout (const Command & command) const override;
+
+    struct Sample
+    {
+        double timeMs = 0.0;
+        juce::Point<float> position;
+        juce::ModifierKeys modifiers;
+        juce::Point<float> wheelDelta;
+    };
+
+    // Expands the command's points into the samples to dispatch, in time order. Returns an
+    // error if the points are missing or out of order.
+    [[nodiscard]] static juce::Result
+    createSamples (const Command & command, std::vector<Sample> & samples);
+
+private:
+    class Playback;
+
+    std::vector<std::unique_ptr<Playback>> _playbacks;
+};
+
+}
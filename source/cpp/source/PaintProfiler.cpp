@@ -0,0 +1,216 @@
+#include "PaintProfiler.h"
+
+#include <focusrite/e2e/ComponentSearch.h>
+
+namespace focusrite::e2e
+{
+static constexpr auto defaultMaxComponents = 10;
+
+[[nodiscard]] static juce::String getProfileId (const juce::Component & component)
+{
+    const auto testId = ComponentSearch::getTestId (component);
+    return testId.isNotEmpty () ? testId : component.getComponentID ();
+}
+
+// Components are painted through their cached image when their parent paints them, so this
+// stands in for the default painting and times it
+class PaintProfiler::PaintHook final : public juce::CachedComponentImage
+{
+public:
+    PaintHook (juce::Component & component, PaintProfiler & profiler)
+        : _component (component)
+        , _profiler (profiler)
+        , _profileId (getProfileId (component))
+    {
+    }
+
+    void paint (juce::Graphics & graphics) override
+    {
+        const auto startMs = juce::Time::getMillisecondCounterHiRes ();
+        _profiler.beginPaint ();
+
+        _component.paintEntireComponent (graphics, false);
+
+        _profiler.endPaint (_profileId, juce::Time::getMillisecondCounterHiRes () - startMs);
+    }
+
+    bool invalidateAll () override
+    {
+        return true;
+    }
+
+    bool invalidate (const juce::Rectangle<int> & area) override
+    {
+        juce::ignoreUnused (area);
+        return true;
+    }
+
+    void releaseResources () override
+    {
+    }
+
+private:
+    juce::Component & _component;
+    PaintProfiler & _profiler;
+    const juce::String _profileId;
+};
+
+PaintProfiler::PaintProfiler () = default;
+
+PaintProfiler::~PaintProfiler ()
+{
+    unhookAll ();
+}
+
+std::optional<Response> PaintProfiler::process (const Command & command)
+{
+    if (command.getType () == "start-paint-profile")
+        return startProfile (command);
+
+    if (command.getType () == "stop-paint-profile")
+    {
+        if (! isProfiling ())
+            return Response::fail ("No paint profile running");
+
+        const auto maxComponents = command.getArgumentAsVar ("max-components");
+        return stop (maxComponents.isVoid () ? defaultMaxComponents : int (maxComponents));
+    }
+
+    return std::nullopt;
+}
+
+Response PaintProfiler::startProfile (const Command & command)
+{
+    if (isProfiling ())
+        return Response::fail ("Paint profile already running");
+
+    const auto componentId = command.getArgument ("component-id");
+    const auto windowId = command.getArgument ("window-id");
+
+    std::vector<juce::Component *> roots;
+
+    if (componentId.isNotEmpty ())
+        roots.push_back (ComponentSearch::findWithId (componentId));
+    else if (windowId.isNotEmpty ())
+        roots.push_back (ComponentSearch::findWindowWithId (windowId));
+    else
+        for (int index = 0; index < juce::TopLevelWindow::getNumTopLevelWindows (); ++index)
+            roots.push_back (juce::TopLevelWindow::getTopLevelWindow (index));
+
+    roots.erase (std::remove (roots.begin (), roots.end (), nullptr), roots.end ());
+
+    if (roots.empty ())
+        return Response::fail ("Nothing to profile");
+
+    start (roots);
+
+    return Response::ok ().withParameter ("components", int (_hooked.size ()));
+}
+
+void PaintProfiler::start (const std::vector<juce::Component *> & roots)
+{
+    unhookAll ();
+    _stats.clear ();
+    _startMs = juce::Time::getMillisecondCounterHiRes ();
+
+    // Windows are painted by their peer rather than through a cached image, so only their
+    // children can be hooked
+    for (auto * root : roots)
+    {
+        if (! root->isOnDesktop ())
+            hook (*root);
+        else
+            for (auto * child : root->getChildren ())
+                hook (*child);
+    }
+}
+
+Response PaintProfiler::stop (int maxComponents)
+{
+    const auto durationMs = juce::Time::getMillisecondCounterHiRes () - _startMs.value_or (0.0);
+
+    unhookAll ();
+    _startMs.reset ();
+
+    std::vector<std::pair<juce::String, Stats>> slowest (_stats.begin (), _stats.end ());
+    std::sort (slowest.begin (),
+               slowest.end (),
+               [] (auto && lhs, auto && rhs) { return lhs.second.totalMs > rhs.second.totalMs; });
+
+    juce::Array<juce::var> components;
+    auto totalMs = 0.0;
+
+    for (const auto & [id, stats] : slowest)
+    {
+        totalMs += stats.totalMs;
+
+        if (components.size () >= maxComponents)
+            continue;
+
+        auto object = std::make_unique<juce::DynamicObject> ();
+        object->setProperty ("test-id", id);
+        object->setProperty ("paints", stats.numPaints);
+        object->setProperty ("total-ms", stats.totalMs);
+        object->setProperty ("mean-ms", stats.totalMs / stats.numPaints);
+        object->setProperty ("max-ms", stats.maxMs);
+        components.add (object.release ());
+    }
+
+    return Response::ok ()
+        .withParameter ("duration-ms", durationMs)
+        .withParameter ("total-ms", totalMs)
+        .withParameter ("components", components);
+}
+
+bool PaintProfiler::isProfiling () const
+{
+    return _startMs.has_value ();
+}
+
+// Components without an id aren't hooked, so their time counts towards their nearest profiled
+// ancestor
+void PaintProfiler::hook (juce::Component & component)
+{
+    if (getProfileId (component).isNotEmpty () && component.getCachedComponentImage () == nullptr)
+    {
+        component.setCachedComponentImage (new PaintHook (component, *this));
+        _hooked.emplace_back (&component);
+    }
+
+    for (auto * child : component.getChildren ())
+        hook (*child);
+}
+
+void PaintProfiler::unhookAll ()
+{
+    for (auto & component : _hooked)
+        if (component != nullptr &&
+            dynamic_cast<PaintHook *> (component->getCachedComponentImage ()) != nullptr)
+            component->setCachedComponentImage (nullptr);
+
+    _hooked.clear ();
+    _childMsStack.clear ();
+}
+
+void PaintProfiler::beginPaint ()
+{
+    _childMsStack.push_back (0.0);
+}
+
+void PaintProfiler::endPaint (const juce::String & testId, double elapsedMs)
+{
+    const auto childMs = _childMsStack.back ();
+    _childMsStack.pop_back ();
+
+    if (! _childMsStack.empty ())
+        _childMsStack.back () += elapsedMs;
+
+    auto & stats = _stats [testId];
+    const auto ownMs = std::max (0.0, elapsedMs - childMs);
+
+    ++stats.numPaints;
+    stats.totalMs += ownMs;
+    stats.maxMs = std::max (stats.maxMs, ownMs);
+}
+
+}
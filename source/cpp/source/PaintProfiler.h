@@ -0,0 +1,55 @@
+#pragma once
+
+#include <focusrite/e2e/CommandHandler.h>
+#include <juce_gui_basics/juce_gui_basics.h>
+#include <map>
+
+namespace focusrite::e2e
+{
+// Handles start-paint-profile and stop-paint-profile: while profiling, times the painting of
+// every component with a test-id and reports the slowest by test-id. Each component's time
+// excludes profiled children, so it is the time spent in its own paint and paintOverChildren
+// plus any unprofiled children.
+class PaintProfiler final : public CommandHandler
+{
+public:
+    PaintProfiler ();
+    ~PaintProfiler () override;
+
+    PaintProfiler (const PaintProfiler &) = delete;
+    PaintProfiler & operator= (const PaintProfiler &) = delete;
+
+    std::optional<Response> process (const Command & command) override;
+
+    // Hooks the components under the roots; components that already have a cached image, such
+    // as those buffered to an image or with an OpenGL context, are skipped
+    void start (const std::vector<juce::Component *> & roots);
+    [[nodiscard]] Response stop (int maxComponents);
+
+    [[nodiscard]] bool isProfiling () const;
+
+private:
+    class PaintHook;
+
+    struct Stats
+    {
+        int numPaints = 0;
+        double totalMs = 0.0;
+        double maxMs = 0.0;
+    };
+
+    [[nodiscard]] Response startProfile (const Command & command);
+
+    void hook (juce::Component & component);
+    void unhookAll ();
+
+    void beginPaint ();
+    void endPaint (const juce::String & testId, double elapsedMs);
+
+    std::vector<juce::Component::SafePointer<juce::Component>> _hooked;
+    std::map<juce::String, Stats> _stats;
+    std::vector<double> _childMsStack;
+    std::optional<double> _startMs;
+};
+
+}
@@ -0,0 +1,70 @@
+#include "PendingResponses.h"
+
+namespace focusrite::e2e
+{
+static constexpr auto deadlineCheckIntervalMs = 50;
+
+PendingResponse::PendingResponse (const Command & command,
+                                  juce::RelativeTime timeout,
+                                  Sender sender)
+    : _uuid (command.getUuid ())
+    , _commandType (command.getType ())
+    , _timeout (timeout)
+    , _deadlineMs (juce::Time::getMillisecondCounterHiRes () + timeout.inMilliseconds ())
+    , _sender (std::move (sender))
+{
+}
+
+void PendingResponse::respond (const Response & response)
+{
+    if (_responded.exchange (true))
+        return;
+
+    _sender (response.withUuid (_uuid));
+}
+
+bool PendingResponse::hasResponded () const
+{
+    return _responded;
+}
+
+bool PendingResponse::hasExpired (double nowMs) const
+{
+    return nowMs >= _deadlineMs;
+}
+
+void PendingResponse::failWithTimeout ()
+{
+    respond (Response::fail ("Timed out after " + juce::String (_timeout.inMilliseconds ()) +
+                             " ms waiting for " + _commandType));
+}
+
+void ResponseDeadlines::track (std::shared_ptr<PendingResponse> response)
+{
+    if (response->hasResponded ())
+        return;
+
+    _responses.push_back (std::move (response));
+
+    if (! isTimerRunning ())
+        startTimer (deadlineCheckIntervalMs);
+}
+
+void ResponseDeadlines::timerCallback ()
+{
+    const auto now = juce::Time::getMillisecondCounterHiRes ();
+
+    for (auto & response : _responses)
+        if (! response->hasResponded () && response->hasExpired (now))
+            response->failWithTimeout ();
+
+    _responses.erase (std::remove_if (_responses.begin (),
+                                      _responses.end (),
+                                      [] (auto && response) { return response->hasResponded (); }),
+                      _responses.end ());
+
+    if (_responses.empty ())
+        stopTimer ();
+}
+
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <focusrite/e2e/AsyncCommandHandler.h>
+#include <atomic>
+#include <juce_events/juce_events.h>
+
+namespace focusrite::e2e
+{
+class PendingResponse final : public Responder
+{
+public:
+    using Sender = std::function<void (const Response &)>;
+
+    PendingResponse (const Command & command, juce::RelativeTime timeout, Sender sender);
+
+    void respond (const Response & response) override;
+    [[nodiscard]] bool hasResponded () const override;
+
+    [[nodiscard]] bool hasExpired (double nowMs) const;
+    void failWithTimeout ();
+
+private:
+    const juce::Uuid _uuid;
+    const juce::String _commandType;
+    const juce::RelativeTime _timeout;
+    const double _deadlineMs;
+    const Sender _sender;
+    std::atomic<bool> _responded {false};
+};
+
+class ResponseDeadlines : private juce::Timer
+{
+public:
+    void track (std::shared_ptr<PendingResponse> response);
+
+private:
+    void timerCallback () override;
+
+    std::vector<std::shared_ptr<PendingResponse>> _responses;
+};
+
+}
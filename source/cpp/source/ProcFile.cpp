@@ -0,0 +1,17 @@
+#include "ProcFile.h"
+
+#include <fstream>
+#include <sstream>
+
+namespace focusrite::e2e
+{
+juce::String readProcFile (const char * path)
+{
+    // Files under /proc report a size of 0, so read them as a stream until the end
+    std::ifstream file (path);
+    std::stringstream contents;
+    contents << file.rdbuf ();
+    return contents.str ();
+}
+
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+namespace focusrite::e2e
+{
+// Returns the contents of a file under /proc, or an empty string if it can't be read
+[[nodiscard]] juce::String readProcFile (const char * path);
+
+}
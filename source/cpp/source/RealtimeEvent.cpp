@@ -0,0 +1,53 @@
+#include <focusrite/e2e/RealtimeEvent.h>
+
+namespace focusrite::e2e
+{
+RealtimeEvent::RealtimeEvent (const char * name) noexcept
+    : _timestamp (juce::Time::getHighResolutionTicks ())
+{
+    for (size_t index = 0; index < maxNameLength && name [index] != '\0'; ++index)
+        _name [index] = name [index];
+}
+
+RealtimeEvent RealtimeEvent::withParameter (const char * name, double value) const noexcept
+{
+    auto other = *this;
+
+    if (other._numParameters < maxParameters)
+    {
+        other._parameterNames [other._numParameters] = name;
+        other._parameterValues [other._numParameters] = value;
+        ++other._numParameters;
+    }
+
+    return other;
+}
+
+const char * RealtimeEvent::getName () const noexcept
+{
+    return _name.data ();
+}
+
+juce::int64 RealtimeEvent::getTimestamp () const noexcept
+{
+    return _timestamp;
+}
+
+size_t RealtimeEvent::getNumParameters () const noexcept
+{
+    return _numParameters;
+}
+
+const char * RealtimeEvent::getParameterName (size_t index) const noexcept
+{
+    jassert (index < _numParameters);
+    return _parameterNames [index];
+}
+
+double RealtimeEvent::getParameterValue (size_t index) const noexcept
+{
+    jassert (index < _numParameters);
+    return _parameterValues [index];
+}
+
+}
@@ -0,0 +1,61 @@
+#include "RealtimeEventQueue.h"
+
+namespace focusrite::e2e
+{
+RealtimeEventQueue::RealtimeEventQueue (size_t capacity)
+    : _cells (capacity)
+    , _mask (capacity - 1)
+{
+    jassert (capacity >= 2 && juce::isPowerOfTwo (capacity));
+
+    for (size_t index = 0; index < capacity; ++index)
+        _cells [index].sequence.store (index, std::memory_order_relaxed);
+}
+
+bool RealtimeEventQueue::push (const RealtimeEvent & event) noexcept
+{
+    auto position = _enqueuePosition.load (std::memory_order_relaxed);
+
+    for (;;)
+    {
+        auto & cell = _cells [position & _mask];
+        const auto sequence = cell.sequence.load (std::memory_order_acquire);
+        const auto difference = std::intptr_t (sequence) - std::intptr_t (position);
+
+        if (difference == 0)
+        {
+            if (_enqueuePosition.compare_exchange_weak (
+                    position, position + 1, std::memory_order_relaxed))
+            {
+                cell.event = event;
+                cell.sequence.store (position + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (difference < 0)
+        {
+            return false;
+        }
+        else
+        {
+            position = _enqueuePosition.load (std::memory_order_relaxed);
+        }
+    }
+}
+
+bool RealtimeEventQueue::pop (RealtimeEvent & event) noexcept
+{
+    auto & cell = _cells [_dequeuePosition & _mask];
+    const auto sequence = cell.sequence.load (std::memory_order_acquire);
+
+    if (std::intptr_t (sequence) - std::intptr_t (_dequeuePosition + 1) < 0)
+        return false;
+
+    event = cell.event;
+    cell.sequence.store (_dequeuePosition + _mask + 1, std::memory_order_release);
+    ++_dequeuePosition;
+
+    return true;
+}
+
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <focusrite/e2e/RealtimeEvent.h>
+#include <atomic>
+#include <vector>
+
+namespace focusrite::e2e
+{
+// Bounded multi-producer, single-consumer queue (after Dmitry Vyukov's bounded MPMC queue).
+// push () never blocks or allocates; it fails when the queue is full.
+class RealtimeEventQueue
+{
+public:
+    explicit RealtimeEventQueue (size_t capacity);
+
+    RealtimeEventQueue (const RealtimeEventQueue &) = delete;
+    RealtimeEventQueue & operator= (const RealtimeEventQueue &) = delete;
+
+    bool push (const RealtimeEvent & event) noexcept;
+    bool pop (RealtimeEvent & event) noexcept;
+
+private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence {0};
+        RealtimeEvent event;
+    };
+
+    std::vector<Cell> _cells;
+    const size_t _mask;
+    alignas (64) std::atomic<size_t> _enqueuePosition {0};
+    alignas (64) size_t _dequeuePosition = 0;
+};
+
+}
@@ -0,0 +1,82 @@
+#include "RealtimeEventWriter.h"
+
+#include "AllocationTracker.h"
+
+#include <focusrite/e2e/Event.h>
+#include <focusrite/e2e/TestCentre.h>
+
+namespace focusrite::e2e
+{
+static constexpr size_t queueCapacity = 4096;
+static constexpr auto drainIntervalMs = 5;
+
+[[nodiscard]] static Event toEvent (const RealtimeEvent & realtimeEvent)
+{
+    const auto timestampMs =
+        juce::Time::highResolutionTicksToSeconds (realtimeEvent.getTimestamp ()) * 1000.0;
+
+    auto event = Event (realtimeEvent.getName ()).withParameter ("timestamp-ms", timestampMs);
+
+    for (size_t index = 0; index < realtimeEvent.getNumParameters (); ++index)
+        event.addParameter (realtimeEvent.getParameterName (index),
+                            realtimeEvent.getParameterValue (index));
+
+    return event;
+}
+
+RealtimeEventWriter::RealtimeEventWriter (TestCentre & testCentre)
+    : juce::Thread ("Realtime event writer")
+    , _testCentre (testCentre)
+    , _queue (queueCapacity)
+{
+}
+
+RealtimeEventWriter::~RealtimeEventWriter ()
+{
+    static constexpr auto waitForever = -1;
+    stopThread (waitForever);
+}
+
+void RealtimeEventWriter::start ()
+{
+    startThread ();
+}
+
+bool RealtimeEventWriter::push (const RealtimeEvent & event) noexcept
+{
+    if (_queue.push (event))
+        return true;
+
+    _numDropped.fetch_add (1, std::memory_order_relaxed);
+    return false;
+}
+
+void RealtimeEventWriter::run ()
+{
+    const AllocationTracker::ScopedOwner owner (AllocationTracker::Owner::library);
+
+    while (! threadShouldExit ())
+    {
+        wait (drainIntervalMs);
+        drain ();
+    }
+}
+
+void RealtimeEventWriter::drain ()
+{
+    RealtimeEvent event;
+
+    while (_queue.pop (event))
+        _testCentre.sendEvent (toEvent (event));
+
+    if (const auto numDropped = _numDropped.exchange (0, std::memory_order_relaxed);
+        numDropped > 0)
+    {
+        _totalDropped += numDropped;
+        _testCentre.sendEvent (Event ("events-dropped")
+                                   .withParameter ("count", numDropped)
+                                   .withParameter ("total", _totalDropped));
+    }
+}
+
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "RealtimeEventQueue.h"
+
+#include <juce_core/juce_core.h>
+
+namespace focusrite::e2e
+{
+class TestCentre;
+
+class RealtimeEventWriter final : private juce::Thread
+{
+public:
+    explicit RealtimeEventWriter (TestCentre & testCentre);
+    ~RealtimeEventWriter () override;
+
+    RealtimeEventWriter (const RealtimeEventWriter &) = delete;
+    RealtimeEventWriter & operator= (const RealtimeEventWriter &) = delete;
+
+    void start ();
+    bool push (const RealtimeEvent & event) noexcept;
+
+private:
+    void run () override;
+    void drain ();
+
+    TestCentre & _testCentre;
+    RealtimeEventQueue _queue;
+    std::atomic<juce::int64> _numDropped {0};
+    juce::int64 _totalDropped = 0;
+};
+
+}
@@ -0,0 +1,38 @@
+#include "ReplayThread.h"
+
+#include "AllocationTracker.h"
+
+namespace focusrite::e2e
+{
+ReplayThread::ReplayThread (TestCentre & testCentre, juce::File log, Replayer::Options options)
+    : juce::Thread ("Session replay")
+    , _replayer (testCentre, std::move (options))
+    , _log (std::move (log))
+{
+}
+
+ReplayThread::~ReplayThread ()
+{
+    static constexpr auto waitForever = -1;
+    stopThread (waitForever);
+}
+
+void ReplayThread::start ()
+{
+    startThread ();
+}
+
+void ReplayThread::run ()
+{
+    const AllocationTracker::ScopedOwner owner (AllocationTracker::Owner::library);
+
+    const auto report = _replayer.replay (_log, [this] { return threadShouldExit (); });
+    const auto json = juce::JSON::toString (report.toVar ());
+
+    juce::Logger::writeToLog ("Replay report: " + json);
+
+    if (! _log.getSiblingFile (_log.getFileName () + ".report.json").replaceWithText (json))
+        juce::Logger::writeToLog ("Couldn't write the replay report");
+}
+
+}
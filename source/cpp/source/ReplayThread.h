@@ -0,0 +1,27 @@
+#pragma once
+
+#include <focusrite/e2e/Replayer.h>
+
+namespace focusrite::e2e
+{
+// Replays a session log given with --e2e-replay=<path> once the app has started, and writes
+// the report next to the log as <log>.report.json
+class ReplayThread final : private juce::Thread
+{
+public:
+    ReplayThread (TestCentre & testCentre, juce::File log, Replayer::Options options);
+    ~ReplayThread () override;
+
+    ReplayThread (const ReplayThread &) = delete;
+    ReplayThread & operator= (const ReplayThread &) = delete;
+
+    void start ();
+
+private:
+    void run () override;
+
+    Replayer _replayer;
+    const juce::File _log;
+};
+
+}
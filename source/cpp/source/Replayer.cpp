@@ -0,0 +1,225 @@
+#include "LatencyHistogram.h"
+#include "SessionLog.h"
+
+#include <focusrite/e2e/Replayer.h>
+
+namespace focusrite::e2e
+{
+static constexpr auto numSlowest = 5;
+static constexpr auto maxSleepMs = 50;
+
+// The UUID is copied from the command, so only the outcome and data are compared
+[[nodiscard]] static juce::var getComparableResponse (const juce::String & json)
+{
+    const auto response = juce::JSON::parse (json);
+
+    auto comparable = std::make_unique<juce::DynamicObject> ();
+    for (const auto * property : {"success", "error", "data"})
+        comparable->setProperty (property, response [property]);
+
+    return comparable.release ();
+}
+
+[[nodiscard]] static bool shouldStop (const std::function<bool ()> & shouldExit)
+{
+    return shouldExit != nullptr && shouldExit ();
+}
+
+static void waitUntil (double timeMs, const std::function<bool ()> & shouldExit)
+{
+    while (! shouldStop (shouldExit))
+    {
+        const auto remainingMs = timeMs - juce::Time::getMillisecondCounterHiRes ();
+        if (remainingMs <= 0.0)
+            return;
+
+        juce::Thread::sleep (std::min (maxSleepMs, int (std::ceil (remainingMs))));
+    }
+}
+
+// Waits in slices so a replay blocked on a busy message thread can still be stopped
+[[nodiscard]] static bool waitForResponse (const std::future<Response> & response,
+                                           double deadlineMs,
+                                           const std::function<bool ()> & shouldExit)
+{
+    while (! shouldStop (shouldExit) && juce::Time::getMillisecondCounterHiRes () < deadlineMs)
+        if (response.wait_for (std::chrono::milliseconds (maxSleepMs)) ==
+            std::future_status::ready)
+            return true;
+
+    return false;
+}
+
+[[nodiscard]] static juce::var createMismatch (int index,
+                                               const Command & command,
+                                               const juce::var & expected,
+                                               const juce::var & actual)
+{
+    auto mismatch = std::make_unique<juce::DynamicObject> ();
+    mismatch->setProperty ("index", index);
+    mismatch->setProperty ("type", command.getType ());
+    mismatch->setProperty ("expected", expected);
+    mismatch->setProperty ("actual", actual);
+    return mismatch.release ();
+}
+
+juce::var Replayer::Report::toVar () const
+{
+    auto report = std::make_unique<juce::DynamicObject> ();
+    report->setProperty ("success", result.wasOk ());
+
+    if (result.failed ())
+        report->setProperty ("error", result.getErrorMessage ());
+
+    report->setProperty ("commands", numCommands);
+    report->setProperty ("skipped", numSkipped);
+    report->setProperty ("recorded-events", numRecordedEvents);
+    report->setProperty ("recorded-duration-ms", recordedDurationMs);
+    report->setProperty ("replayed-duration-ms", replayedDurationMs);
+    report->setProperty ("recorded-latency-us", recordedLatency);
+    report->setProperty ("replayed-latency-us", replayedLatency);
+    report->setProperty ("mismatches", mismatches);
+    report->setProperty ("slowest", slowest);
+    return report.release ();
+}
+
+Replayer::Replayer (TestCentre & testCentre, Options options)
+    : _testCentre (testCentre)
+    , _options (std::move (options))
+{
+}
+
+Replayer::Report Replayer::replay (const juce::File & log,
+                                   const std::function<bool ()> & shouldExit)
+{
+    Report report;
+
+    std::vector<SessionLog::Entry> entries;
+    report.result = SessionLog::read (log, entries);
+    if (report.result.failed ())
+        return report;
+
+    std::vector<const SessionLog::Entry *> commands;
+    std::map<juce::String, const SessionLog::Entry *> responses;
+
+    for (const auto & entry : entries)
+    {
+        switch (entry.kind)
+        {
+            case SessionLog::Kind::command:
+                commands.push_back (&entry);
+                break;
+            case SessionLog::Kind::response:
+                responses [juce::JSON::parse (entry.json) ["uuid"].toString ()] = &entry;
+                break;
+            case SessionLog::Kind::event:
+                ++report.numRecordedEvents;
+                break;
+        }
+    }
+
+    if (commands.empty ())
+        return report;
+
+    const auto firstCommandUs = commands.front ()->timeUs;
+    report.recordedDurationMs = double (entries.back ().timeUs - firstCommandUs) / 1000.0;
+
+    struct Latency
+    {
+        int index = 0;
+        juce::String type;
+        double recordedMs = 0.0;
+        double replayedMs = 0.0;
+    };
+
+    LatencyHistogram recordedLatency;
+    LatencyHistogram replayedLatency;
+    std::vector<Latency> latencies;
+
+    const auto startMs = juce::Time::getMillisecondCounterHiRes ();
+
+    for (auto index = 0; index < int (commands.size ()); ++index)
+    {
+        const auto & entry = *commands [static_cast<size_t> (index)];
+        const auto command = Command::fromJson (entry.json);
+
+        if (! command.isValid ())
+            continue;
+
+        if (_options.skippedCommandTypes.contains (command.getType ()))
+        {
+            ++report.numSkipped;
+            continue;
+        }
+
+        if (_options.speed > 0.0)
+            waitUntil (startMs + double (entry.timeUs - firstCommandUs) / 1000.0 / _options.speed,
+                       shouldExit);
+
+        if (shouldStop (shouldExit))
+        {
+            report.result = juce::Result::fail ("Replay stopped");
+            break;
+        }
+
+        const auto recorded = responses.find (command.getUuid ().toDashedString ());
+        const auto expected = recorded != responses.end ()
+                                  ? getComparableResponse (recorded->second->json)
+                                  : juce::var ("No recorded response");
+
+        const auto submitMs = juce::Time::getMillisecondCounterHiRes ();
+        auto response = _testCentre.submit (command);
+        ++report.numCommands;
+
+        if (! waitForResponse (response, submitMs + _options.timeout.inMilliseconds (), shouldExit))
+        {
+            if (shouldStop (shouldExit))
+            {
+                report.result = juce::Result::fail ("Replay stopped");
+                break;
+            }
+
+            report.mismatches.add (createMismatch (index, command, expected, "Timed out"));
+            continue;
+        }
+
+        const auto replayedMs = juce::Time::getMillisecondCounterHiRes () - submitMs;
+        const auto actual = getComparableResponse (response.get ().toJson ());
+        replayedLatency.record (uint64_t (replayedMs * 1000.0));
+
+        if (recorded != responses.end ())
+        {
+            const auto recordedMs = double (recorded->second->timeUs - entry.timeUs) / 1000.0;
+            recordedLatency.record (uint64_t (std::max (0.0, recordedMs) * 1000.0));
+            latencies.push_back ({index, command.getType (), recordedMs, replayedMs});
+        }
+
+        if (juce::JSON::toString (expected, true) != juce::JSON::toString (actual, true))
+            report.mismatches.add (createMismatch (index, command, expected, actual));
+    }
+
+    report.replayedDurationMs = juce::Time::getMillisecondCounterHiRes () - startMs;
+    report.recordedLatency = recordedLatency.toVar ();
+    report.replayedLatency = replayedLatency.toVar ();
+
+    std::sort (latencies.begin (),
+               latencies.end (),
+               [] (auto && a, auto && b)
+               { return a.replayedMs - a.recordedMs > b.replayedMs - b.recordedMs; });
+
+    for (size_t index = 0; index < std::min (latencies.size (), size_t (numSlowest)); ++index)
+    {
+        const auto & latency = latencies [index];
+
+        auto slow = std::make_unique<juce::DynamicObject> ();
+        slow->setProperty ("index", latency.index);
+        slow->setProperty ("type", latency.type);
+        slow->setProperty ("recorded-ms", latency.recordedMs);
+        slow->setProperty ("replayed-ms", latency.replayedMs);
+        report.slowest.add (slow.release ());
+    }
+
+    return report;
+}
+
+}
@@ -1,7 +1,49 @@
+#include <charconv>
 #include <focusrite/e2e/Response.h>
 
 namespace focusrite::e2e
 {
+// Writes the uuid in the same dashed form as juce::Uuid::toDashedString, without the string
+static void writeUuid (juce::OutputStream & output, const juce::Uuid & uuid)
+{
+    static constexpr auto hexDigits = "0123456789abcdef";
+    const auto * bytes = uuid.getRawData ();
+
+    for (size_t index = 0; index < 16; ++index)
+    {
+        if (index == 4 || index == 6 || index == 8 || index == 10)
+            output.writeByte ('-');
+
+        output.writeByte (hexDigits [bytes [index] >> 4]);
+        output.writeByte (hexDigits [bytes [index] & 0xf]);
+    }
+}
+
+static void writeValue (juce::OutputStream & output, const juce::var & value)
+{
+    // juce::JSON formats integers through a temporary string
+    if (value.isInt () || value.isInt64 ())
+    {
+        char digits [24];
+        const auto result =
+            std::to_chars (std::begin (digits), std::end (digits), juce::int64 (value));
+        output.write (digits, size_t (result.ptr - digits));
+        return;
+    }
+
+    juce::JSON::writeToStream (output, value, true);
+}
+
+template <typename Function>
+void Response::forEachParameter (Function && function) const
+{
+    for (size_t index = 0; index < _numParameters; ++index)
+        function (_parameters [index]);
+
+    for (const auto & parameter : _moreParameters)
+        function (parameter);
+}
+
 Response Response::ok ()
 {
     return Response (juce::Result::ok ());
@@ -17,7 +59,7 @@ Response::Response (juce::Result result)
 {
 }
 
-Response Response::withParameter (const juce::String & name, const juce::var & value) const
+Response Response::withParameter (const juce::Identifier & name, const juce::var & value) const
 {
     Response other (*this);
     other.addParameter (name, value);
@@ -31,27 +73,69 @@ Response Response::withUuid (const juce::Uuid & uuid) const
     return other;
 }
 
+juce::Uuid Response::getUuid () const
+{
+    return _uuid;
+}
+
+juce::Result Response::getResult () const
+{
+    return _result;
+}
+
+juce::var Response::getParameter (const juce::Identifier & name) const
+{
+    juce::var value;
+
+    forEachParameter (
+        [&] (const Parameter & parameter)
+        {
+            if (parameter.name == name)
+                value = parameter.value;
+        });
+
+    return value;
+}
+
 juce::String Response::toJson () const
 {
-    auto element = std::make_unique<juce::DynamicObject> ();
-    element->setProperty ("type", "response");
-    element->setProperty ("uuid", _uuid.toDashedString ());
-    element->setProperty ("success", _result.wasOk ());
+    juce::MemoryOutputStream output;
+    writeJson (output);
+    return output.toUTF8 ();
+}
+
+void Response::writeJson (juce::OutputStream & output) const
+{
+    output << "{\"type\":\"response\",\"uuid\":\"";
+    writeUuid (output, _uuid);
+    output << "\",\"success\":" << (_result.wasOk () ? "true" : "false");
 
     if (! _result)
-        element->setProperty ("error", _result.getErrorMessage ());
+    {
+        output << ",\"error\":";
+        juce::JSON::writeToStream (output, _result.getErrorMessage (), true);
+    }
 
-    if (! _parameters.empty ())
+    if (_numParameters > 0)
     {
-        auto data = std::make_unique<juce::DynamicObject> ();
+        output << ",\"data\":{";
+        auto first = true;
+
+        forEachParameter (
+            [&] (const Parameter & parameter)
+            {
+                if (! std::exchange (first, false))
+                    output << ",";
 
-        for (const auto & [key, value] : _parameters)
-            data->setProperty (key, value);
+                juce::JSON::writeToStream (output, parameter.name.toString (), true);
+                output << ":";
+                writeValue (output, parameter.value);
+            });
 
-        element->setProperty ("data", data.release ());
+        output << "}";
     }
 
-    return juce::JSON::toString (element.release ());
+    output << "}";
 }
 
 juce::String Response::describe () const
@@ -64,15 +148,41 @@ juce::String Response::describe () const
     if (! _result)
         description << "Error: " << _result.getErrorMessage ();
 
-    for (auto && [key, value] : _parameters)
-        description << key << ": " << value.toString () << juce::newLine;
+    forEachParameter (
+        [&] (const Parameter & parameter)
+        {
+            description << parameter.name.toString () << ": " << parameter.value.toString ()
+                        << juce::newLine;
+        });
 
     return description;
 }
 
-void Response::addParameter (const juce::String & name, const juce::var & value)
+void Response::addParameter (const juce::Identifier & name, const juce::var & value)
+{
+    if (auto * parameter = findParameter (name))
+    {
+        parameter->value = value;
+        return;
+    }
+
+    if (_numParameters < numInlineParameters)
+        _parameters [_numParameters++] = {name, value};
+    else
+        _moreParameters.push_back ({name, value});
+}
+
+Response::Parameter * Response::findParameter (const juce::Identifier & name)
 {
-    _parameters [name] = value;
+    for (size_t index = 0; index < _numParameters; ++index)
+        if (_parameters [index].name == name)
+            return &_parameters [index];
+
+    for (auto & parameter : _moreParameters)
+        if (parameter.name == name)
+            return &parameter;
+
+    return nullptr;
 }
 
 }
@@ -0,0 +1,126 @@
+#include "ScratchArena.h"
+
+namespace focusrite::e2e
+{
+static constexpr size_t alignment = alignof (std::max_align_t);
+static constexpr size_t minimumStreamCapacity = 256;
+
+struct Arena
+{
+    std::unique_ptr<char []> block;
+    size_t capacity = 0;
+    size_t used = 0;
+
+    // Allocations that didn't fit in the block, freed when the outermost scope ends
+    std::vector<std::unique_ptr<char []>> overflow;
+    size_t overflowBytes = 0;
+
+    int numScopes = 0;
+};
+
+static thread_local Arena arena;
+
+[[nodiscard]] static size_t alignUp (size_t numBytes) noexcept
+{
+    return (std::max (numBytes, size_t (1)) + alignment - 1) & ~(alignment - 1);
+}
+
+static void reset ()
+{
+    if (arena.overflowBytes > 0)
+    {
+        const auto capacity = std::min (alignUp (arena.capacity + arena.overflowBytes),
+                                        ScratchArena::maxCapacity);
+
+        if (capacity != arena.capacity)
+        {
+            arena.capacity = capacity;
+            arena.block.reset (new char [capacity]);
+        }
+
+        arena.overflow.clear ();
+        arena.overflowBytes = 0;
+    }
+
+    arena.used = 0;
+}
+
+ScratchArena::Scope::Scope () noexcept
+{
+    ++arena.numScopes;
+}
+
+ScratchArena::Scope::~Scope ()
+{
+    if (--arena.numScopes == 0)
+        reset ();
+}
+
+void * ScratchArena::allocate (size_t numBytes)
+{
+    jassert (arena.numScopes > 0);
+
+    const auto size = alignUp (numBytes);
+
+    if (arena.capacity - arena.used >= size)
+        return arena.block.get () + std::exchange (arena.used, arena.used + size);
+
+    arena.overflowBytes += size;
+    return arena.overflow.emplace_back (new char [size]).get ();
+}
+
+size_t ScratchArena::getCapacity () noexcept
+{
+    return arena.capacity;
+}
+
+const char * ScratchArena::OutputStream::getData () const noexcept
+{
+    return _data;
+}
+
+size_t ScratchArena::OutputStream::getDataSize () const noexcept
+{
+    return _size;
+}
+
+void ScratchArena::OutputStream::flush ()
+{
+}
+
+bool ScratchArena::OutputStream::setPosition (juce::int64 newPosition)
+{
+    if (newPosition < 0 || size_t (newPosition) > _size)
+        return false;
+
+    _position = size_t (newPosition);
+    return true;
+}
+
+juce::int64 ScratchArena::OutputStream::getPosition ()
+{
+    return juce::int64 (_position);
+}
+
+bool ScratchArena::OutputStream::write (const void * data, size_t numBytes)
+{
+    if (_position + numBytes > _capacity)
+    {
+        const auto capacity =
+            std::max ({_capacity * 2, _position + numBytes, minimumStreamCapacity});
+        auto * grown = static_cast<char *> (allocate (capacity));
+
+        if (_size > 0)
+            std::memcpy (grown, _data, _size);
+
+        _data = grown;
+        _capacity = capacity;
+    }
+
+    std::memcpy (_data + _position, data, numBytes);
+    _position += numBytes;
+    _size = std::max (_size, _position);
+    return true;
+}
+
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+namespace focusrite::e2e
+{
+// Scratch memory for handling a command on the current thread, such as the bytes read from the
+// socket and the JSON written back. Memory is carved out of a block that each thread keeps
+// between commands, and is all released at once when the outermost Scope on the thread ends.
+// If a command needs more than the block holds, the block grows when the scope ends, so once
+// the arena has seen the largest command it stops allocating. The block never grows past
+// maxCapacity, so a rare large command doesn't pin its memory on the thread.
+class ScratchArena
+{
+public:
+    static constexpr size_t maxCapacity = 256 * 1024;
+
+    class Scope
+    {
+    public:
+        Scope () noexcept;
+        ~Scope ();
+
+        Scope (const Scope &) = delete;
+        Scope & operator= (const Scope &) = delete;
+    };
+
+    // Stays valid until the outermost Scope on this thread ends
+    [[nodiscard]] static void * allocate (size_t numBytes);
+
+    // The size of this thread's block
+    [[nodiscard]] static size_t getCapacity () noexcept;
+
+    // Collects what's written in scratch memory, so it's only valid inside a Scope
+    class OutputStream final : public juce::OutputStream
+    {
+    public:
+        [[nodiscard]] const char * getData () const noexcept;
+        [[nodiscard]] size_t getDataSize () const noexcept;
+
+        void flush () override;
+        bool setPosition (juce::int64 newPosition) override;
+        juce::int64 getPosition () override;
+        bool write (const void * data, size_t numBytes) override;
+
+    private:
+        char * _data = nullptr;
+        size_t _size = 0;
+        size_t _position = 0;
+        size_t _capacity = 0;
+    };
+};
+
+}
@@ -0,0 +1,286 @@
+#include "Screenshot.h"
+
+namespace focusrite::e2e
+{
+static constexpr auto deltaTileSize = 32;
+
+juce::String encodeImageAsBase64Png (const juce::Image & image)
+{
+    juce::MemoryOutputStream rawStream;
+
+    juce::PNGImageFormat imageFormat;
+    if (! imageFormat.writeImageToStream (image, rawStream))
+        return {};
+
+    return juce::Base64::toBase64 (rawStream.getData (), rawStream.getDataSize ());
+}
+
+static void accumulateRow (uint32_t * sums, const juce::uint8 * row, size_t numBytes)
+{
+    for (size_t index = 0; index < numBytes; ++index)
+        sums [index] += row [index];
+}
+
+juce::Image downscaleImage (const juce::Image & image, int width, int height)
+{
+    jassert (0 < width && width <= image.getWidth ());
+    jassert (0 < height && height <= image.getHeight ());
+
+    // Box filter on premultiplied pixels: whole source rows are summed into a row of
+    // accumulators first, so the inner loop runs over contiguous bytes and vectorises
+    static constexpr auto numChannels = 4;
+
+    const auto source = image.convertedToFormat (juce::Image::ARGB);
+    juce::Image destination (juce::Image::ARGB, width, height, false);
+
+    const juce::Image::BitmapData sourceData (source, juce::Image::BitmapData::readOnly);
+    const juce::Image::BitmapData destinationData (destination,
+                                                   juce::Image::BitmapData::writeOnly);
+
+    const auto rowSize = static_cast<size_t> (source.getWidth () * numChannels);
+    std::vector<uint32_t> rowSums (rowSize);
+
+    for (auto y = 0; y < height; ++y)
+    {
+        const auto sourceTop = y * source.getHeight () / height;
+        const auto sourceBottom = std::max (sourceTop + 1, (y + 1) * source.getHeight () / height);
+
+        std::fill (rowSums.begin (), rowSums.end (), 0u);
+
+        for (auto sourceY = sourceTop; sourceY < sourceBottom; ++sourceY)
+            accumulateRow (rowSums.data (), sourceData.getLinePointer (sourceY), rowSize);
+
+        auto * output = destinationData.getLinePointer (y);
+
+        for (auto x = 0; x < width; ++x)
+        {
+            const auto sourceLeft = x * source.getWidth () / width;
+            const auto sourceRight =
+                std::max (sourceLeft + 1, (x + 1) * source.getWidth () / width);
+            const auto numSamples =
+                static_cast<uint32_t> ((sourceRight - sourceLeft) * (sourceBottom - sourceTop));
+
+            for (auto channel = 0; channel < numChannels; ++channel)
+            {
+                uint32_t sum = 0;
+
+                for (auto sourceX = sourceLeft; sourceX < sourceRight; ++sourceX)
+                    sum += rowSums [static_cast<size_t> (sourceX * numChannels + channel)];
+
+                *output++ = static_cast<juce::uint8> ((sum + numSamples / 2) / numSamples);
+            }
+        }
+    }
+
+    return destination;
+}
+
+[[nodiscard]] static bool
+bytesDiffer (const juce::uint8 * a, const juce::uint8 * b, size_t numBytes)
+{
+    // No early exit inside a row: a branch-free OR-reduction lets the compiler vectorise the loop
+    uint64_t difference = 0;
+    size_t offset = 0;
+
+    for (; offset + sizeof (uint64_t) <= numBytes; offset += sizeof (uint64_t))
+    {
+        uint64_t wordA = 0;
+        uint64_t wordB = 0;
+        std::memcpy (&wordA, a + offset, sizeof (wordA));
+        std::memcpy (&wordB, b + offset, sizeof (wordB));
+        difference |= wordA ^ wordB;
+    }
+
+    for (; offset < numBytes; ++offset)
+        difference |= uint64_t (a [offset] ^ b [offset]);
+
+    return difference != 0;
+}
+
+[[nodiscard]] static bool tileDiffers (const juce::Image::BitmapData & previous,
+                                       const juce::Image::BitmapData & current,
+                                       const juce::Rectangle<int> & tile)
+{
+    const auto numBytes = static_cast<size_t> (tile.getWidth () * current.pixelStride);
+
+    for (auto y = tile.getY (); y < tile.getBottom (); ++y)
+        if (bytesDiffer (previous.getPixelPointer (tile.getX (), y),
+                         current.getPixelPointer (tile.getX (), y),
+                         numBytes))
+            return true;
+
+    return false;
+}
+
+[[nodiscard]] static std::vector<juce::Rectangle<int>>
+findChangedTilesInRow (const juce::Image::BitmapData & previous,
+                       const juce::Image::BitmapData & current,
+                       int tileY,
+                       int tileSize)
+{
+    std::vector<juce::Rectangle<int>> runs;
+    const auto tileHeight = std::min (tileSize, current.height - tileY);
+
+    for (auto tileX = 0; tileX < current.width; tileX += tileSize)
+    {
+        const juce::Rectangle<int> tile (
+            tileX, tileY, std::min (tileSize, current.width - tileX), tileHeight);
+
+        if (! tileDiffers (previous, current, tile))
+            continue;
+
+        if (! runs.empty () && runs.back ().getRight () == tile.getX ())
+            runs.back ().setRight (tile.getRight ());
+        else
+            runs.push_back (tile);
+    }
+
+    return runs;
+}
+
+std::vector<juce::Rectangle<int>>
+findChangedRegions (const juce::Image & previous, const juce::Image & current, int tileSize)
+{
+    jassert (tileSize > 0);
+    jassert (previous.getBounds () == current.getBounds ());
+    jassert (previous.getFormat () == current.getFormat ());
+
+    const juce::Image::BitmapData previousData (previous, juce::Image::BitmapData::readOnly);
+    const juce::Image::BitmapData currentData (current, juce::Image::BitmapData::readOnly);
+
+    std::vector<juce::Rectangle<int>> regions;
+    std::vector<size_t> regionsEndingAtRow;
+
+    for (auto tileY = 0; tileY < current.getHeight (); tileY += tileSize)
+    {
+        std::vector<size_t> regionsEndingAtNextRow;
+
+        for (auto & run : findChangedTilesInRow (previousData, currentData, tileY, tileSize))
+        {
+            auto above = std::find_if (regionsEndingAtRow.begin (),
+                                       regionsEndingAtRow.end (),
+                                       [&] (auto && index)
+                                       {
+                                           return regions [index].getX () == run.getX () &&
+                                                  regions [index].getRight () == run.getRight ();
+                                       });
+
+            if (above != regionsEndingAtRow.end ())
+            {
+                regions [*above].setBottom (run.getBottom ());
+                regionsEndingAtNextRow.push_back (*above);
+            }
+            else
+            {
+                regionsEndingAtNextRow.push_back (regions.size ());
+                regions.push_back (run);
+            }
+        }
+
+        regionsEndingAtRow = std::move (regionsEndingAtNextRow);
+    }
+
+    return regions;
+}
+
+[[nodiscard]] static juce::String encodeRegionAsBase64Rgba (const juce::Image::BitmapData & data,
+                                                             const juce::Rectangle<int> & region)
+{
+    juce::MemoryOutputStream compressedStream;
+
+    {
+        juce::GZIPCompressorOutputStream stream (compressedStream);
+        std::vector<juce::uint8> row (static_cast<size_t> (region.getWidth ()) * 4);
+
+        for (auto y = region.getY (); y < region.getBottom (); ++y)
+        {
+            auto * output = row.data ();
+
+            for (auto x = region.getX (); x < region.getRight (); ++x)
+            {
+                auto pixel =
+                    *reinterpret_cast<const juce::PixelARGB *> (data.getPixelPointer (x, y));
+                pixel.unpremultiply ();
+
+                *output++ = pixel.getRed ();
+                *output++ = pixel.getGreen ();
+                *output++ = pixel.getBlue ();
+                *output++ = pixel.getAlpha ();
+            }
+
+            stream.write (row.data (), row.size ());
+        }
+    }
+
+    return juce::Base64::toBase64 (compressedStream.getData (), compressedStream.getDataSize ());
+}
+
+Response ScreenshotHistory::createDelta (const juce::String & key,
+                                         const juce::Image & image,
+                                         bool forceKeyframe)
+{
+    const auto current = image.convertedToFormat (juce::Image::ARGB);
+    auto & previous = getPreviousCapture (key);
+
+    const auto keyframe =
+        forceKeyframe || previous.isNull () || previous.getBounds () != current.getBounds ();
+
+    const auto regions = keyframe ? std::vector<juce::Rectangle<int>> {current.getBounds ()}
+                                  : findChangedRegions (previous, current, deltaTileSize);
+
+    juce::Array<juce::var> rects;
+
+    {
+        const juce::Image::BitmapData data (current, juce::Image::BitmapData::readOnly);
+
+        for (const auto & region : regions)
+        {
+            auto rect = std::make_unique<juce::DynamicObject> ();
+            rect->setProperty ("x", region.getX ());
+            rect->setProperty ("y", region.getY ());
+            rect->setProperty ("width", region.getWidth ());
+            rect->setProperty ("height", region.getHeight ());
+            rect->setProperty ("pixels", encodeRegionAsBase64Rgba (data, region));
+            rects.add (rect.release ());
+        }
+    }
+
+    previous = current;
+
+    return Response::ok ()
+        .withParameter ("keyframe", keyframe)
+        .withParameter ("width", current.getWidth ())
+        .withParameter ("height", current.getHeight ())
+        .withParameter ("rects", rects);
+}
+
+juce::Image & ScreenshotHistory::getPreviousCapture (const juce::String & key)
+{
+    ++_numUses;
+
+    const auto matchesKey = [&] (auto && capture) { return capture.key == key; };
+    auto capture = std::find_if (_previousCaptures.begin (), _previousCaptures.end (), matchesKey);
+
+    if (capture == _previousCaptures.end ())
+    {
+        if (_previousCaptures.size () < maxCaptures)
+        {
+            capture = _previousCaptures.emplace (_previousCaptures.end ());
+        }
+        else
+        {
+            capture = std::min_element (_previousCaptures.begin (),
+                                        _previousCaptures.end (),
+                                        [] (auto && a, auto && b)
+                                        { return a.lastUsed < b.lastUsed; });
+            capture->image = {};
+        }
+
+        capture->key = key;
+    }
+
+    capture->lastUsed = _numUses;
+    return capture->image;
+}
+
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <focusrite/e2e/Response.h>
+#include <juce_gui_basics/juce_gui_basics.h>
+#include <vector>
+
+namespace focusrite::e2e
+{
+[[nodiscard]] juce::String encodeImageAsBase64Png (const juce::Image & image);
+
+[[nodiscard]] juce::Image downscaleImage (const juce::Image & image, int width, int height);
+
+[[nodiscard]] std::vector<juce::Rectangle<int>>
+findChangedRegions (const juce::Image & previous, const juce::Image & current, int tileSize);
+
+// Remembers the last capture of the most recently used keys; a key that has been forgotten gets
+// a keyframe next time
+class ScreenshotHistory
+{
+public:
+    static constexpr size_t maxCaptures = 16;
+
+    [[nodiscard]] Response createDelta (const juce::String & key,
+                                        const juce::Image & image,
+                                        bool forceKeyframe);
+
+private:
+    struct Capture
+    {
+        juce::String key;
+        juce::Image image;
+        juce::uint64 lastUsed = 0;
+    };
+
+    [[nodiscard]] juce::Image & getPreviousCapture (const juce::String & key);
+
+    std::vector<Capture> _previousCaptures;
+    juce::uint64 _numUses = 0;
+};
+
+}
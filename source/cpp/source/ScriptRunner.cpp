@@ -0,0 +1,268 @@
+#include "ScriptRunner.h"
+
+#include <future>
+#include <optional>
+
+namespace focusrite::e2e
+{
+static constexpr auto pollIntervalMs = 10;
+static constexpr auto defaultWaitTimeoutMs = 5'000;
+
+[[nodiscard]] static bool isSleep (const juce::var & step)
+{
+    return step.getProperty ("type", {}).toString () == "sleep";
+}
+
+[[nodiscard]] static bool isWait (const juce::var & step)
+{
+    return step.getProperty ("wait", false);
+}
+
+[[nodiscard]] static double getSleepMs (const juce::var & step)
+{
+    return juce::jmax (0.0, double (step.getProperty ("args", {}).getProperty ("ms", 0.0)));
+}
+
+[[nodiscard]] static double getWaitTimeoutMs (const juce::var & step)
+{
+    return juce::jmax (0.0, double (step.getProperty ("timeout-ms", defaultWaitTimeoutMs)));
+}
+
+[[nodiscard]] static juce::String describeStep (int index, const juce::var & step)
+{
+    return "Step " + juce::String (index) + " (" + step.getProperty ("type", {}).toString () +
+           ")";
+}
+
+// Objects and arrays are compared by their JSON, as var compares them by reference
+[[nodiscard]] static bool matches (const juce::var & actual, const juce::var & expected)
+{
+    if (expected.isObject () || expected.isArray ())
+        return juce::JSON::toString (actual, true) == juce::JSON::toString (expected, true);
+
+    return actual == expected;
+}
+
+class ScriptRunner::Script final : private juce::Timer
+{
+public:
+    Script (TestCentre & testCentre, juce::var steps, std::shared_ptr<Responder> responder)
+        : _testCentre (testCentre)
+        , _steps (std::move (steps))
+        , _responder (std::move (responder))
+    {
+    }
+
+    void start ()
+    {
+        advance ();
+
+        if (! isFinished ())
+            startTimer (pollIntervalMs);
+    }
+
+    [[nodiscard]] bool isFinished () const
+    {
+        return _responder->hasResponded ();
+    }
+
+private:
+    void timerCallback () override
+    {
+        advance ();
+
+        if (isFinished ())
+            stopTimer ();
+    }
+
+    void advance ()
+    {
+        while (! isFinished ())
+        {
+            if (_nextStep == _steps.size ())
+            {
+                _responder->respond (Response::ok ().withParameter ("steps", _results));
+                return;
+            }
+
+            if (! runStep (_steps [_nextStep]))
+                return;
+        }
+    }
+
+    // Returns true once the step has passed and the next one can start
+    bool runStep (const juce::var & step)
+    {
+        const auto nowMs = juce::Time::getMillisecondCounterHiRes ();
+
+        if (! _stepStartMs)
+            _stepStartMs = nowMs;
+
+        if (isSleep (step))
+            return nowMs - *_stepStartMs >= getSleepMs (step) && completeStep (nowMs);
+
+        if (! _pending)
+        {
+            if (nowMs < _nextAttemptMs)
+                return false;
+
+            ++_attempts;
+            _pending = _testCentre.submit (
+                Command::create (step ["type"].toString (), step.getProperty ("args", {})));
+        }
+
+        if (_pending->wait_for (std::chrono::seconds (0)) != std::future_status::ready)
+            return false;
+
+        const auto response = _pending->get ();
+        _pending.reset ();
+
+        const auto result = check (response, step.getProperty ("expect", {}));
+        const auto finishedMs = juce::Time::getMillisecondCounterHiRes ();
+
+        if (result.wasOk ())
+            return completeStep (finishedMs);
+
+        if (isWait (step) && finishedMs - *_stepStartMs < getWaitTimeoutMs (step))
+        {
+            _nextAttemptMs = finishedMs + pollIntervalMs;
+            return false;
+        }
+
+        addResult (finishedMs);
+        _responder->respond (
+            Response::fail (describeStep (_nextStep, step) + ": " + result.getErrorMessage ())
+                .withParameter ("failed-step", _nextStep)
+                .withParameter ("steps", _results));
+        return false;
+    }
+
+    bool completeStep (double finishedMs)
+    {
+        addResult (finishedMs);
+
+        ++_nextStep;
+        _stepStartMs.reset ();
+        _nextAttemptMs = 0.0;
+        _attempts = 0;
+        return true;
+    }
+
+    void addResult (double finishedMs)
+    {
+        auto result = std::make_unique<juce::DynamicObject> ();
+        result->setProperty ("type", _steps [_nextStep]["type"]);
+        result->setProperty ("duration-ms", finishedMs - *_stepStartMs);
+
+        if (_attempts > 0)
+            result->setProperty ("attempts", _attempts);
+
+        _results.append (result.release ());
+    }
+
+    TestCentre & _testCentre;
+    const juce::var _steps;
+    const std::shared_ptr<Responder> _responder;
+    juce::var _results = juce::Array<juce::var> ();
+    int _nextStep = 0;
+    std::optional<double> _stepStartMs;
+    double _nextAttemptMs = 0.0;
+    int _attempts = 0;
+    std::optional<std::future<Response>> _pending;
+};
+
+ScriptRunner::ScriptRunner (TestCentre & testCentre)
+    : _testCentre (testCentre)
+{
+}
+
+ScriptRunner::~ScriptRunner () = default;
+
+bool ScriptRunner::process (const Command & command, std::shared_ptr<Responder> responder)
+{
+    if (command.getType () != "run-script")
+        return false;
+
+    _scripts.erase (std::remove_if (_scripts.begin (),
+                                    _scripts.end (),
+                                    [] (auto && script) { return script->isFinished (); }),
+                    _scripts.end ());
+
+    const auto steps = command.getArgumentAsVar ("steps");
+
+    if (const auto result = validate (steps); result.failed ())
+    {
+        responder->respond (Response::fail (result.getErrorMessage ()));
+        return true;
+    }
+
+    auto & script =
+        *_scripts.emplace_back (std::make_unique<Script> (_testCentre, steps, responder));
+    script.start ();
+
+    return true;
+}
+
+juce::RelativeTime ScriptRunner::getTimeout (const Command & command) const
+{
+    auto timeoutMs = 0.0;
+
+    if (const auto * steps = command.getArgumentAsVar ("steps").getArray ())
+        for (const auto & step : *steps)
+            timeoutMs += isSleep (step) ? getSleepMs (step)
+                                        : (isWait (step) ? getWaitTimeoutMs (step) : 0.0);
+
+    return AsyncCommandHandler::getTimeout (command) +
+           juce::RelativeTime::milliseconds (juce::int64 (timeoutMs));
+}
+
+juce::Result ScriptRunner::validate (const juce::var & steps)
+{
+    if (! steps.isArray ())
+        return juce::Result::fail ("Missing steps");
+
+    for (int index = 0; index < steps.size (); ++index)
+    {
+        const auto & step = steps [index];
+        const auto type = step.getProperty ("type", {}).toString ();
+
+        if (! step.isObject () || type.isEmpty ())
+            return juce::Result::fail ("Step " + juce::String (index) + " has no type");
+
+        if (type == "run-script")
+            return juce::Result::fail (describeStep (index, step) + ": scripts can't be nested");
+
+        if (isSleep (step) && isWait (step))
+            return juce::Result::fail (describeStep (index, step) + ": can't wait on a sleep");
+
+        const auto expect = step.getProperty ("expect", {});
+        if (! expect.isVoid () && ! expect.isObject ())
+            return juce::Result::fail (describeStep (index, step) + ": expect isn't an object");
+    }
+
+    return juce::Result::ok ();
+}
+
+juce::Result ScriptRunner::check (const Response & response, const juce::var & expect)
+{
+    if (const auto result = response.getResult (); result.failed ())
+        return result;
+
+    if (const auto * expected = expect.getDynamicObject ())
+    {
+        for (const auto & property : expected->getProperties ())
+        {
+            const auto name = property.name.toString ();
+            const auto actual = response.getParameter (name);
+
+            if (! matches (actual, property.value))
+                return juce::Result::fail ("Expected " + name + " to be " +
+                                           juce::JSON::toString (property.value, true) +
+                                           " but was " + juce::JSON::toString (actual, true));
+        }
+    }
+
+    return juce::Result::ok ();
+}
+
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <focusrite/e2e/AsyncCommandHandler.h>
+#include <focusrite/e2e/TestCentre.h>
+#include <juce_events/juce_events.h>
+
+namespace focusrite::e2e
+{
+// Handles run-script: runs a list of steps on the message thread in a single command. Each step
+// is any other command, optionally with expected response values, and can wait for those values
+// by polling until a timeout. Steps that respond immediately run back to back; the rest are
+// picked up again by a timer.
+class ScriptRunner final : public AsyncCommandHandler
+{
+public:
+    explicit ScriptRunner (TestCentre & testCentre);
+    ~ScriptRunner () override;
+
+    ScriptRunner (const ScriptRunner &) = delete;
+    ScriptRunner & operator= (const ScriptRunner &) = delete;
+
+    bool process (const Command & command, std::shared_ptr<Responder> responder) override;
+    [[nodiscard]] juce::RelativeTime getTimeout (const Command & command) const override;
+
+    // Returns an error describing the first step that can't be run
+    [[nodiscard]] static juce::Result validate (const juce::var & steps);
+
+    // Returns an error if the response failed or any expected parameter differs
+    [[nodiscard]] static juce::Result check (const Response & response, const juce::var & expect);
+
+private:
+    class Script;
+
+    TestCentre & _testCentre;
+    std::vector<std::unique_ptr<Script>> _scripts;
+};
+
+}
@@ -0,0 +1,94 @@
+#include "SessionLog.h"
+
+namespace focusrite::e2e
+{
+static constexpr char fileMagic [] = {'F', 'E', '2', 'E', 'L', 'O', 'G', '1'};
+static constexpr auto bufferSize = 64 * 1024;
+static constexpr auto flushIntervalMs = 1000.0;
+
+juce::Result SessionLog::read (const juce::File & file, std::vector<Entry> & entries)
+{
+    juce::FileInputStream stream (file);
+    if (! stream.openedOk ())
+        return juce::Result::fail ("Couldn't open " + file.getFullPathName ());
+
+    char magic [sizeof (fileMagic)] {};
+    if (stream.read (magic, sizeof (magic)) != int (sizeof (magic)) ||
+        std::memcmp (magic, fileMagic, sizeof (magic)) != 0)
+        return juce::Result::fail (file.getFullPathName () + " is not a session log");
+
+    entries.clear ();
+
+    static constexpr auto entryHeaderSize = 1 + 8 + 4;
+
+    while (stream.getNumBytesRemaining () >= entryHeaderSize)
+    {
+        Entry entry;
+        entry.kind = static_cast<Kind> (stream.readByte ());
+        entry.timeUs = stream.readInt64 ();
+
+        const auto size = static_cast<uint32_t> (stream.readInt ());
+        if (stream.getNumBytesRemaining () < juce::int64 (size))
+            break;
+
+        juce::MemoryBlock payload (size);
+        stream.read (payload.getData (), int (size));
+        entry.json = payload.toString ();
+
+        entries.push_back (std::move (entry));
+    }
+
+    return juce::Result::ok ();
+}
+
+std::shared_ptr<SessionLogWriter> SessionLogWriter::create (const juce::File & file)
+{
+    if (! file.getParentDirectory ().createDirectory () || ! file.deleteFile ())
+        return nullptr;
+
+    auto stream = std::make_unique<juce::FileOutputStream> (file, bufferSize);
+    if (! stream->openedOk () || ! stream->write (fileMagic, sizeof (fileMagic)))
+        return nullptr;
+
+    return std::shared_ptr<SessionLogWriter> (new SessionLogWriter (std::move (stream)));
+}
+
+SessionLogWriter::SessionLogWriter (std::unique_ptr<juce::FileOutputStream> stream)
+    : _stream (std::move (stream))
+    , _startMs (juce::Time::getMillisecondCounterHiRes ())
+    , _lastFlushMs (_startMs)
+{
+}
+
+SessionLogWriter::~SessionLogWriter ()
+{
+    flush ();
+}
+
+void SessionLogWriter::append (SessionLog::Kind kind, const juce::String & json)
+{
+    const auto nowMs = juce::Time::getMillisecondCounterHiRes ();
+    const auto size = json.getNumBytesAsUTF8 ();
+
+    const juce::ScopedLock lock (_lock);
+
+    _stream->writeByte (static_cast<char> (kind));
+    _stream->writeInt64 (juce::roundToInt64 ((nowMs - _startMs) * 1000.0));
+    _stream->writeInt (static_cast<int> (size));
+    _stream->write (json.toRawUTF8 (), size);
+
+    // Bounds how much of the session a crash can lose without flushing every entry
+    if (nowMs - _lastFlushMs >= flushIntervalMs)
+    {
+        _stream->flush ();
+        _lastFlushMs = nowMs;
+    }
+}
+
+void SessionLogWriter::flush ()
+{
+    const juce::ScopedLock lock (_lock);
+    _stream->flush ();
+}
+
+}
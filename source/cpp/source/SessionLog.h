@@ -0,0 +1,56 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+namespace focusrite::e2e
+{
+// Binary log of a test session. After an 8-byte file header, each entry is a kind byte, the
+// time since recording started in microseconds (int64), the payload size (uint32) and the
+// payload, all little-endian. Payloads are the JSON exchanged with the harness.
+class SessionLog
+{
+public:
+    enum class Kind : juce::uint8
+    {
+        command = 1,
+        response = 2,
+        event = 3,
+    };
+
+    struct Entry
+    {
+        Kind kind = Kind::command;
+        juce::int64 timeUs = 0;
+        juce::String json;
+    };
+
+    // Reads every entry of a log; fails if the file is missing or isn't a session log. A
+    // truncated final entry (e.g. after a crash) is ignored.
+    [[nodiscard]] static juce::Result read (const juce::File & file, std::vector<Entry> & entries);
+};
+
+class SessionLogWriter
+{
+public:
+    // Returns nullptr if the file can't be written
+    static std::shared_ptr<SessionLogWriter> create (const juce::File & file);
+
+    ~SessionLogWriter ();
+
+    SessionLogWriter (const SessionLogWriter &) = delete;
+    SessionLogWriter & operator= (const SessionLogWriter &) = delete;
+
+    // Safe from any thread
+    void append (SessionLog::Kind kind, const juce::String & json);
+    void flush ();
+
+private:
+    explicit SessionLogWriter (std::unique_ptr<juce::FileOutputStream> stream);
+
+    juce::CriticalSection _lock;
+    const std::unique_ptr<juce::FileOutputStream> _stream;
+    const double _startMs;
+    double _lastFlushMs;
+};
+
+}
@@ -0,0 +1,159 @@
+#include "StallMonitor.h"
+
+#include "AllocationTracker.h"
+
+#include <focusrite/e2e/Event.h>
+#include <focusrite/e2e/TestCentre.h>
+
+namespace focusrite::e2e
+{
+static constexpr auto heartbeatIntervalMs = 10;
+
+// Stalls are numbered from the last reset; older ones have been overwritten in the ring
+[[nodiscard]] static size_t getOldestRetainedStall (size_t numStalls)
+{
+    return numStalls - std::min (numStalls, StallMonitor::maxStalls);
+}
+
+StallMonitor::StallMonitor (TestCentre & testCentre, int thresholdMs)
+    : juce::Thread ("Stall monitor")
+    , _testCentre (testCentre)
+    , _thresholdMs (thresholdMs)
+    , _startMs (juce::Time::getMillisecondCounterHiRes ())
+{
+    startThread ();
+}
+
+StallMonitor::~StallMonitor ()
+{
+    static constexpr auto waitForever = -1;
+    stopThread (waitForever);
+}
+
+std::optional<Response> StallMonitor::process (const Command & command)
+{
+    if (command.getType () == "get-stall-report")
+        return getReport (command);
+
+    return std::nullopt;
+}
+
+CommandHandler::ThreadAffinity StallMonitor::getThreadAffinity (const Command & command) const
+{
+    juce::ignoreUnused (command);
+    return ThreadAffinity::anyThread;
+}
+
+void StallMonitor::run ()
+{
+    const AllocationTracker::ScopedOwner owner (AllocationTracker::Owner::library);
+
+    while (! threadShouldExit ())
+    {
+        if (! _state->heartbeatPending)
+        {
+            _ongoingStallReported = false;
+            sendNewStallEvents ();
+            postHeartbeat ();
+        }
+        else if (const auto waitingMs =
+                     juce::Time::getMillisecondCounterHiRes () - _state->heartbeatPostedMs;
+                 ! _ongoingStallReported && waitingMs > _thresholdMs)
+        {
+            _ongoingStallReported = true;
+            _testCentre.sendEvent (
+                Event ("message-thread-stall-detected")
+                    .withParameter ("start-ms", _state->heartbeatPostedMs - _startMs)
+                    .withParameter ("waiting-ms", waitingMs));
+        }
+
+        wait (heartbeatIntervalMs);
+    }
+}
+
+void StallMonitor::postHeartbeat ()
+{
+    _state->heartbeatPostedMs = juce::Time::getMillisecondCounterHiRes ();
+    _state->heartbeatPending = true;
+
+    juce::MessageManager::callAsync (
+        [state = _state, startMs = _startMs, thresholdMs = _thresholdMs]
+        {
+            const auto postedMs = state->heartbeatPostedMs.load ();
+            const auto latencyMs = juce::Time::getMillisecondCounterHiRes () - postedMs;
+
+            state->heartbeatLatency.record (uint64_t (latencyMs * 1000.0));
+            ++state->numHeartbeats;
+
+            if (latencyMs > thresholdMs)
+            {
+                const juce::ScopedLock lock (state->lock);
+                state->stalls [state->numStalls++ % maxStalls] = {postedMs - startMs, latencyMs};
+                state->maxStallMs = std::max (state->maxStallMs, latencyMs);
+            }
+
+            state->heartbeatPending = false;
+        });
+}
+
+void StallMonitor::sendNewStallEvents ()
+{
+    std::vector<Stall> newStalls;
+
+    {
+        const juce::ScopedLock lock (_state->lock);
+
+        const auto numStalls = _state->numStalls;
+        const auto first = _numStallsReported > numStalls
+                               ? getOldestRetainedStall (numStalls)
+                               : std::max (_numStallsReported, getOldestRetainedStall (numStalls));
+
+        for (auto index = first; index < numStalls; ++index)
+            newStalls.push_back (_state->stalls [index % maxStalls]);
+
+        _numStallsReported = numStalls;
+    }
+
+    for (const auto & stall : newStalls)
+        _testCentre.sendEvent (Event ("message-thread-stall")
+                                   .withParameter ("start-ms", stall.startMs)
+                                   .withParameter ("duration-ms", stall.durationMs));
+}
+
+Response StallMonitor::getReport (const Command & command)
+{
+    const juce::ScopedLock lock (_state->lock);
+
+    juce::Array<juce::var> stalls;
+
+    for (auto index = getOldestRetainedStall (_state->numStalls); index < _state->numStalls;
+         ++index)
+    {
+        const auto & stall = _state->stalls [index % maxStalls];
+
+        auto object = std::make_unique<juce::DynamicObject> ();
+        object->setProperty ("start-ms", stall.startMs);
+        object->setProperty ("duration-ms", stall.durationMs);
+        stalls.add (object.release ());
+    }
+
+    auto response = Response::ok ()
+                        .withParameter ("threshold-ms", _thresholdMs)
+                        .withParameter ("heartbeats", _state->numHeartbeats.load ())
+                        .withParameter ("heartbeat-latency-us", _state->heartbeatLatency.toVar ())
+                        .withParameter ("max-stall-ms", _state->maxStallMs)
+                        .withParameter ("stall-count", int (_state->numStalls))
+                        .withParameter ("stalls", stalls);
+
+    if (command.getArgumentAsVar ("reset"))
+    {
+        _state->numStalls = 0;
+        _state->maxStallMs = 0.0;
+        _state->heartbeatLatency.reset ();
+        _state->numHeartbeats = 0;
+    }
+
+    return response;
+}
+
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "LatencyHistogram.h"
+
+#include <array>
+#include <focusrite/e2e/CommandHandler.h>
+#include <juce_events/juce_events.h>
+
+namespace focusrite::e2e
+{
+class TestCentre;
+
+class StallMonitor final
+    : public CommandHandler
+    , private juce::Thread
+{
+public:
+    // Only the latest stalls are listed in the report; the count and maximum cover them all
+    static constexpr size_t maxStalls = 256;
+
+    StallMonitor (TestCentre & testCentre, int thresholdMs);
+    ~StallMonitor () override;
+
+    StallMonitor (const StallMonitor &) = delete;
+    StallMonitor & operator= (const StallMonitor &) = delete;
+
+    std::optional<Response> process (const Command & command) override;
+    [[nodiscard]] ThreadAffinity getThreadAffinity (const Command & command) const override;
+
+private:
+    struct Stall
+    {
+        double startMs = 0.0;
+        double durationMs = 0.0;
+    };
+
+    // Shared with heartbeats still queued on the message thread, which may outlive the monitor
+    struct State
+    {
+        std::atomic<bool> heartbeatPending {false};
+        std::atomic<double> heartbeatPostedMs {0.0};
+        std::atomic<int> numHeartbeats {0};
+        LatencyHistogram heartbeatLatency;
+
+        juce::CriticalSection lock;
+        std::array<Stall, maxStalls> stalls;
+        size_t numStalls = 0;
+        double maxStallMs = 0.0;
+    };
+
+    void run () override;
+
+    void postHeartbeat ();
+    void sendNewStallEvents ();
+    [[nodiscard]] Response getReport (const Command & command);
+
+    TestCentre & _testCentre;
+    const int _thresholdMs;
+    const double _startMs;
+    const std::shared_ptr<State> _state = std::make_shared<State> ();
+    size_t _numStallsReported = 0;
+    bool _ongoingStallReported = false;
+};
+
+}
@@ -0,0 +1,75 @@
+#include "StartupTimes.h"
+
+#include "ProcFile.h"
+
+#if JUCE_LINUX
+#include <unistd.h>
+#elif JUCE_MAC
+#include <sys/sysctl.h>
+#include <unistd.h>
+#endif
+
+namespace focusrite::e2e
+{
+// Set when the library is loaded, which is as close to the process starting as portable code gets
+static const auto libraryLoadedMs = juce::Time::currentTimeMillis ();
+
+Event StartupTimes::createHandshake (juce::int64 testCentreCreatedMs,
+                                     const std::vector<juce::int64> & connectAttemptsMs)
+{
+    juce::Array<juce::var> attempts;
+
+    for (const auto attemptMs : connectAttemptsMs)
+        attempts.add (attemptMs);
+
+    return Event ("handshake")
+        .withParameter ("process-start-ms", getProcessStartMs ())
+        .withParameter ("test-centre-created-ms", testCentreCreatedMs)
+        .withParameter ("connect-attempts-ms", attempts)
+        .withParameter ("ready-ms", juce::Time::currentTimeMillis ());
+}
+
+juce::int64 StartupTimes::getProcessStartMs ()
+{
+#if JUCE_LINUX
+    // The start time is counted from boot, so it's turned into the process's age using the uptime
+    const auto startTicks = parseStartTicks (readProcFile ("/proc/self/stat"));
+    const auto uptimeSeconds = juce::String (readProcFile ("/proc/uptime")).getDoubleValue ();
+    const auto ticksPerSecond = sysconf (_SC_CLK_TCK);
+
+    if (startTicks && uptimeSeconds > 0.0 && ticksPerSecond > 0)
+    {
+        const auto ageSeconds = uptimeSeconds - double (*startTicks) / double (ticksPerSecond);
+        return juce::Time::currentTimeMillis () - juce::int64 (ageSeconds * 1000.0);
+    }
+#elif JUCE_MAC
+    int name [] {CTL_KERN, KERN_PROC, KERN_PROC_PID, getpid ()};
+    kinfo_proc info {};
+    auto size = sizeof (info);
+
+    if (sysctl (name, 4, &info, &size, nullptr, 0) == 0 && size > 0)
+    {
+        const auto & startTime = info.kp_proc.p_starttime;
+        return juce::int64 (startTime.tv_sec) * 1000 + juce::int64 (startTime.tv_usec) / 1000;
+    }
+#endif
+
+    return libraryLoadedMs;
+}
+
+std::optional<juce::int64> StartupTimes::parseStartTicks (const juce::String & stat)
+{
+    // The command name is in brackets and may contain spaces or brackets itself, so the fields are
+    // counted from the last closing bracket, which is followed by the third field
+    static constexpr auto startTimeIndex = 22 - 3;
+
+    const auto fields = juce::StringArray::fromTokens (
+        stat.fromLastOccurrenceOf (")", false, false).trim (), false);
+
+    if (! stat.contains (")") || fields.size () <= startTimeIndex)
+        return std::nullopt;
+
+    return fields [startTimeIndex].getLargeIntValue ();
+}
+
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <focusrite/e2e/Event.h>
+#include <optional>
+
+namespace focusrite::e2e
+{
+// Builds the handshake event, the first message sent once connected, which reports how long the
+// app took to get ready for commands. Times are in milliseconds since the epoch, so the harness
+// can compare them with when it launched the app.
+class StartupTimes
+{
+public:
+    [[nodiscard]] static Event createHandshake (juce::int64 testCentreCreatedMs,
+                                                const std::vector<juce::int64> & connectAttemptsMs);
+
+    // Where the platform can't say when the process started, this is when the library was loaded
+    [[nodiscard]] static juce::int64 getProcessStartMs ();
+
+    // Returns the start time, in clock ticks since boot, from /proc/self/stat-style text
+    [[nodiscard]] static std::optional<juce::int64> parseStartTicks (const juce::String & stat);
+};
+
+}
@@ -1,55 +1,248 @@
+#include "AllocationTracker.h"
+#include "AppMetrics.h"
+#include "CommandMetrics.h"
+#include "CommandParser.h"
+#include "ConnectedTestCentre.h"
 #include "Connection.h"
 #include "DefaultCommandHandler.h"
+#include "EventThrottle.h"
+#include "FrameCapture.h"
+#include "IdleDetector.h"
+#include "MemoryStats.h"
+#include "MessageThreadQueue.h"
+#include "MouseGesture.h"
+#include "PaintProfiler.h"
+#include "PendingResponses.h"
+#include "RealtimeEventWriter.h"
+#include "ReplayThread.h"
+#include "ScratchArena.h"
+#include "ScriptRunner.h"
+#include "SessionLog.h"
+#include "StallMonitor.h"
+#include "StartupTimes.h"
+#include "TextTyper.h"
+#include "Tracer.h"
+#include "VirtualClock.h"
 
 #include <focusrite/e2e/Command.h>
 #include <focusrite/e2e/Event.h>
 #include <focusrite/e2e/TestCentre.h>
+#include <focusrite/e2e/Trace.h>
 #include <juce_events/juce_events.h>
 
 namespace focusrite::e2e
 {
-[[nodiscard]] static std::optional<int> getPort ()
+[[nodiscard]] static std::optional<juce::String> getCommandLineOption (const juce::String & option)
 {
     for (const auto & param : juce::JUCEApplicationBase::getCommandLineParameterArray ())
+        if (param.startsWith (option))
+            return param.substring (option.length ());
+
+    return std::nullopt;
+}
+
+[[nodiscard]] static std::optional<int> getPort ()
+{
+    if (const auto option = getCommandLineOption ("--e2e-test-port="))
     {
-        if (param.contains ("--e2e-test-port="))
-        {
-            int port = param.trimCharactersAtStart ("--e2e-test-port=").getIntValue ();
-            if (std::numeric_limits<uint16_t>::min () <= port &&
-                port <= std::numeric_limits<uint16_t>::max ())
-                return port;
-        }
+        int port = option->getIntValue ();
+        if (std::numeric_limits<uint16_t>::min () <= port &&
+            port <= std::numeric_limits<uint16_t>::max ())
+            return port;
     }
 
     return std::nullopt;
 }
 
+[[nodiscard]] static int getConnectTimeoutMs ()
+{
+    if (const auto option = getCommandLineOption ("--e2e-connect-timeout="))
+        if (const auto timeoutMs = option->getIntValue (); timeoutMs > 0)
+            return timeoutMs;
+
+    return Connection::defaultConnectTimeoutMs;
+}
+
+[[nodiscard]] static std::optional<int> getStallThresholdMs ()
+{
+    static constexpr auto defaultStallThresholdMs = 50;
+
+    const auto option = getCommandLineOption ("--e2e-stall-monitor");
+    if (! option)
+        return std::nullopt;
+
+    const auto thresholdMs = option->trimCharactersAtStart ("=").getIntValue ();
+    return thresholdMs > 0 ? thresholdMs : defaultStallThresholdMs;
+}
+
+[[nodiscard]] static juce::File getFileOption (const juce::String & option)
+{
+    return juce::File::getCurrentWorkingDirectory ().getChildFile (
+        getCommandLineOption (option).value_or (juce::String ()));
+}
+
+[[nodiscard]] static Replayer::Options getReplayOptions ()
+{
+    Replayer::Options options;
+
+    if (const auto speed = getCommandLineOption ("--e2e-replay-speed="))
+        options.speed = std::max (0.0, speed->getDoubleValue ());
+
+    return options;
+}
+
+[[nodiscard]] static const char * getTraceDetail (const Command & command)
+{
+    return Trace::isEnabled () ? Tracer::intern (command.getType ()) : nullptr;
+}
+
+static void logCommand (TestCentre::LogLevel logLevel, const Command & command)
+{
+    if (logLevel == TestCentre::LogLevel::silent)
+        return;
+
+    juce::Logger::writeToLog ("Received command: ");
+    juce::Logger::writeToLog (command.describe ());
+}
+
+static void logResponse (TestCentre::LogLevel logLevel, const Response & response)
+{
+    if (logLevel == TestCentre::LogLevel::silent)
+        return;
+
+    juce::Logger::writeToLog ("Sending response: ");
+    juce::Logger::writeToLog (response.describe ());
+}
+
+static void send (Connection * connection, const char * data, size_t size)
+{
+    if (connection != nullptr && connection->isConnected ())
+        connection->send (data, size);
+}
+
+static void send (Connection * connection, const juce::String & data)
+{
+    send (connection, data.toRawUTF8 (), data.getNumBytesAsUTF8 ());
+}
+
+static void record (SessionLogWriter * recorder, SessionLog::Kind kind, const juce::String & json)
+{
+    if (recorder != nullptr)
+        recorder->append (kind, json);
+}
+
+static void record (SessionLogWriter * recorder,
+                    SessionLog::Kind kind,
+                    const char * json,
+                    size_t size)
+{
+    if (recorder != nullptr)
+        recorder->append (kind, juce::String::fromUTF8 (json, int (size)));
+}
+
+// Receives the response to a command submitted in-process; like PendingResponse, only the first
+// response counts
+class LocalResponse
+{
+public:
+    [[nodiscard]] std::future<Response> getFuture ()
+    {
+        return _promise.get_future ();
+    }
+
+    void set (const Response & response)
+    {
+        if (! _set.exchange (true))
+            _promise.set_value (response);
+    }
+
+private:
+    std::promise<Response> _promise;
+    std::atomic<bool> _set {false};
+};
+
 class E2ETestCentre final : public TestCentre
 {
 public:
-    E2ETestCentre (LogLevel logLevel)
+    E2ETestCentre (LogLevel logLevel, std::optional<int> port)
         : _logLevel (logLevel)
     {
-        auto port = getPort ();
+        if (getCommandLineOption ("--e2e-trace="))
+            Tracer::start (getFileOption ("--e2e-trace="));
+
+        if (getCommandLineOption ("--e2e-record="))
+        {
+            _recorder = SessionLogWriter::create (getFileOption ("--e2e-record="));
+
+            if (_recorder == nullptr)
+                juce::Logger::writeToLog ("Couldn't create the session log");
+        }
+
+        // The built-in commands and replaying don't need a connection, so that submit () works
+        // without one
+        addBuiltInCommandHandler (_defaultCommandHandler);
+        addBuiltInCommandHandler (_frameCapture);
+        addBuiltInCommandHandler (*_metrics);
+        addBuiltInCommandHandler (_appMetrics);
+        addBuiltInCommandHandler (_eventThrottle);
+        addBuiltInCommandHandler (_virtualClock);
+        addBuiltInCommandHandler (_paintProfiler);
+        addBuiltInCommandHandler (_memoryStats);
+        addBuiltInCommandHandler (*_allocationTracker);
+        addBuiltInAsyncCommandHandler (_textTyper);
+        addBuiltInAsyncCommandHandler (_mouseGesture);
+        addBuiltInAsyncCommandHandler (_scriptRunner);
+        addBuiltInAsyncCommandHandler (_idleDetector);
+
+        if (getCommandLineOption ("--e2e-replay="))
+        {
+            _replayThread = std::make_unique<ReplayThread> (
+                *this, getFileOption ("--e2e-replay="), getReplayOptions ());
+            _replayThread->start ();
+        }
+
         if (! port)
             return;
 
-        addCommandHandler (_defaultCommandHandler);
+        if (const auto stallThresholdMs = getStallThresholdMs ())
+        {
+            _stallMonitor = std::make_unique<StallMonitor> (*this, *stallThresholdMs);
+            addBuiltInCommandHandler (*_stallMonitor);
+        }
 
-        _connection = Connection::create (*port);
-        _connection->_onDataReceived = [this] (auto && block) { onDataReceived (block); };
+        _connection = Connection::create (*port, getConnectTimeoutMs ());
+        _connection->_onConnected = [this] (auto && connectAttemptsMs)
+        { sendHandshake (connectAttemptsMs); };
+        _connection->_onDataReceived = [this] (auto * data, auto size, auto readMs)
+        { onDataReceived (data, size, readMs); };
         _connection->start ();
+        _realtimeEventWriter.start ();
     }
 
-    ~E2ETestCentre () override = default;
+    ~E2ETestCentre () override
+    {
+        _replayThread.reset ();
+        _eventThrottle.stop ();
+
+        if (_connection)
+            _connection->stop ();
+
+        if (Trace::isEnabled ())
+            juce::ignoreUnused (Tracer::flush ());
+
+        Tracer::stop ();
+    }
 
     void addCommandHandler (CommandHandler & handler) override
     {
+        const juce::ScopedWriteLock lock (_commandHandlersLock);
         _commandHandlers.emplace_back (handler);
     }
 
     void removeCommandHandler (CommandHandler & handler) override
     {
+        const juce::ScopedWriteLock lock (_commandHandlersLock);
+
         auto it = std::remove_if (_commandHandlers.begin (),
                                   _commandHandlers.end (),
                                   [&] (auto && other) { return &handler == &other.get (); });
@@ -57,74 +250,395 @@ public:
         _commandHandlers.erase (it, _commandHandlers.end ());
     }
 
+    void addAsyncCommandHandler (AsyncCommandHandler & handler) override
+    {
+        const juce::ScopedWriteLock lock (_commandHandlersLock);
+        _asyncCommandHandlers.emplace_back (handler);
+    }
+
+    void removeAsyncCommandHandler (AsyncCommandHandler & handler) override
+    {
+        const juce::ScopedWriteLock lock (_commandHandlersLock);
+
+        auto it = std::remove_if (_asyncCommandHandlers.begin (),
+                                  _asyncCommandHandlers.end (),
+                                  [&] (auto && other) { return &handler == &other.get (); });
+
+        _asyncCommandHandlers.erase (it, _asyncCommandHandlers.end ());
+    }
+
+    std::future<Response> submit (const Command & command) override
+    {
+        auto localResponse = std::make_shared<LocalResponse> ();
+        auto future = localResponse->getFuture ();
+
+        if (! command.isValid ())
+        {
+            localResponse->set (Response::fail ("Invalid command").withUuid (command.getUuid ()));
+            return future;
+        }
+
+        logCommand (_logLevel, command);
+        dispatch (command, {}, std::move (localResponse));
+        return future;
+    }
+
     void sendEvent (const Event & event) override
     {
-        send (event.toJson ());
+        _eventThrottle.send (event);
+    }
+
+    void setEventPolicy (const juce::String & eventName, const EventPolicy & policy) override
+    {
+        _eventThrottle.setPolicy (eventName, policy);
+    }
+
+    bool sendRealtimeEvent (const RealtimeEvent & event) noexcept override
+    {
+        return _realtimeEventWriter.push (event);
+    }
+
+    void resetMetrics () override
+    {
+        _metrics->reset ();
+    }
+
+    Counter & getCounter (const juce::String & name) override
+    {
+        return _appMetrics.getCounter (name);
+    }
+
+    Gauge & getGauge (const juce::String & name) override
+    {
+        return _appMetrics.getGauge (name);
+    }
+
+    Histogram & getHistogram (const juce::String & name) override
+    {
+        return _appMetrics.getHistogram (name);
+    }
+
+    const TimeSource & getTimeSource () const override
+    {
+        return _timeSource;
     }
 
 private:
-    void send (const juce::String & data)
+    // Handlers added by the library itself, whose allocations are counted as the library's
+    void addBuiltInCommandHandler (CommandHandler & handler)
+    {
+        _builtInHandlers.push_back (&handler);
+        addCommandHandler (handler);
+    }
+
+    void addBuiltInAsyncCommandHandler (AsyncCommandHandler & handler)
+    {
+        _builtInHandlers.push_back (&handler);
+        addAsyncCommandHandler (handler);
+    }
+
+    [[nodiscard]] AllocationTracker::Owner getAllocationOwner (const void * handler) const
+    {
+        return std::find (_builtInHandlers.begin (), _builtInHandlers.end (), handler) !=
+                       _builtInHandlers.end ()
+                   ? AllocationTracker::Owner::library
+                   : AllocationTracker::Owner::app;
+    }
+
+    // Sent before any command is read, so it's always the first message the harness receives
+    void sendHandshake (const std::vector<juce::int64> & connectAttemptsMs)
     {
-        if (_connection && _connection->isConnected ())
-            _connection->send ({data.toRawUTF8 (), data.getNumBytesAsUTF8 ()});
+        const auto json = StartupTimes::createHandshake (_createdMs, connectAttemptsMs).toJson ();
+        send (_connection.get (), json);
+        record (_recorder.get (), SessionLog::Kind::event, json);
     }
 
-    void onDataReceived (const juce::MemoryBlock & data)
+    void onDataReceived (const char * data, size_t size, double readMs)
     {
-        auto command = Command::fromJson (data.toString ());
+        const AllocationTracker::ScopedOwner owner (AllocationTracker::Owner::library);
+        AllocationTracker::ScopedCommand allocations (*_allocationTracker);
+
+        const auto parseStartMs = juce::Time::getMillisecondCounterHiRes ();
+
+        auto command = _parser.parse (data, size);
         if (! command.isValid ())
             return;
 
-        logCommand (command);
+        allocations.setCommandType (command.getType ());
+        logCommand (_logLevel, command);
+        record (_recorder.get (), SessionLog::Kind::command, data, size);
+
+        CommandTiming timing;
+        timing.readMs = readMs + juce::Time::getMillisecondCounterHiRes () - parseStartMs;
+
+        dispatch (command, timing, nullptr);
+    }
+
+    void dispatch (const Command & command,
+                   CommandTiming timing,
+                   std::shared_ptr<LocalResponse> localResponse)
+    {
+        {
+            const ScopedTrace trace ("dispatch", getTraceDetail (command));
+
+            if (process (command,
+                         CommandHandler::ThreadAffinity::anyThread,
+                         timing,
+                         localResponse.get ()))
+                return;
+        }
+
+        if (juce::MessageManager::existsAndIsCurrentThread ())
+        {
+            processOnMessageThread (command, timing, localResponse);
+            return;
+        }
+
+        const auto postedMs = juce::Time::getMillisecondCounterHiRes ();
+
+        _commandQueue.post ({command, timing, localResponse, postedMs});
+    }
+
+    void processOnMessageThread (const Command & command,
+                                 CommandTiming & timing,
+                                 const std::shared_ptr<LocalResponse> & localResponse)
+    {
+        const ScopedTrace trace ("dispatch", getTraceDetail (command));
+        const AllocationTracker::ScopedOwner owner (AllocationTracker::Owner::library);
+        const AllocationTracker::ScopedCommand allocations (*_allocationTracker,
+                                                            command.getType ());
+
+        if (process (command,
+                     CommandHandler::ThreadAffinity::messageThread,
+                     timing,
+                     localResponse.get ()))
+            return;
+
+        if (processAsync (command, timing, localResponse))
+            return;
+
+        respond (command, Response::fail ("Unhandled message"), timing, localResponse.get ());
+    }
+
+    bool process (const Command & command,
+                  CommandHandler::ThreadAffinity threadAffinity,
+                  CommandTiming & timing,
+                  LocalResponse * localResponse)
+    {
+        const juce::ScopedReadLock lock (_commandHandlersLock);
 
         bool responded = false;
 
         for (auto & commandHandler : _commandHandlers)
         {
-            auto response = commandHandler.get ().process (command);
+            if (commandHandler.get ().getThreadAffinity (command) != threadAffinity)
+                continue;
+
+            const auto handlerStartMs = juce::Time::getMillisecondCounterHiRes ();
+            juce::ignoreUnused (ScopedSearchTimer::takeElapsedMs ());
+
+            auto response = [&]
+            {
+                const ScopedTrace trace ("process", getTraceDetail (command));
+                const AllocationTracker::ScopedOwner owner (
+                    getAllocationOwner (&commandHandler.get ()));
+                return commandHandler.get ().process (command);
+            }();
+
+            const auto searchMs = ScopedSearchTimer::takeElapsedMs ();
+            timing.searchMs += searchMs;
+            timing.handlerMs +=
+                juce::Time::getMillisecondCounterHiRes () - handlerStartMs - searchMs;
+
             if (! response)
                 continue;
 
-            logResponse (*response);
-            send (response->withUuid (command.getUuid ()).toJson ());
+            respond (command, *response, timing, localResponse);
             responded = true;
+        }
+
+        return responded;
+    }
+
+    void respond (const Command & command,
+                  const Response & response,
+                  CommandTiming & timing,
+                  LocalResponse * localResponse)
+    {
+        logResponse (_logLevel, response);
+
+        if (localResponse != nullptr)
+        {
+            localResponse->set (response.withUuid (command.getUuid ()));
+        }
+        else
+        {
+            const ScratchArena::Scope scratch;
+
+            const auto serializeStartMs = juce::Time::getMillisecondCounterHiRes ();
+            ScratchArena::OutputStream json;
+            response.withUuid (command.getUuid ()).writeJson (json);
+            const auto writeStartMs = juce::Time::getMillisecondCounterHiRes ();
+
+            {
+                const ScopedTrace trace ("send", getTraceDetail (command));
+                send (_connection.get (), json.getData (), json.getDataSize ());
+            }
+
+            record (
+                _recorder.get (), SessionLog::Kind::response, json.getData (), json.getDataSize ());
 
-            if (command.getType () == "quit")
-                juce::JUCEApplicationBase::quit ();
+            timing.serializeMs = writeStartMs - serializeStartMs;
+            timing.writeMs = juce::Time::getMillisecondCounterHiRes () - writeStartMs;
         }
 
-        if (! responded)
-            send (Response::fail ("Unhandled message").withUuid (command.getUuid ()).toJson ());
+        _metrics->record (command.getType (), timing);
+
+        // Only the harness can quit the app; a submitted or replayed quit is just answered
+        if (localResponse == nullptr && command.getType () == "quit")
+            juce::MessageManager::callAsync ([] { juce::JUCEApplicationBase::quit (); });
     }
 
-    void logCommand (const Command & command)
+    bool processAsync (const Command & command,
+                       const CommandTiming & timing,
+                       const std::shared_ptr<LocalResponse> & localResponse)
     {
-        if (_logLevel == LogLevel::silent)
-            return;
+        const juce::ScopedReadLock lock (_commandHandlersLock);
+
+        for (auto & commandHandler : _asyncCommandHandlers)
+        {
+            auto responder =
+                std::make_shared<PendingResponse> (command,
+                                                   commandHandler.get ().getTimeout (command),
+                                                   createSender (command, timing, localResponse));
+
+            const auto processed = [&]
+            {
+                const AllocationTracker::ScopedOwner owner (
+                    getAllocationOwner (&commandHandler.get ()));
+                return commandHandler.get ().process (command, responder);
+            }();
+
+            if (! processed)
+                continue;
+
+            _responseDeadlines.track (std::move (responder));
+            return true;
+        }
 
-        juce::Logger::writeToLog ("Received command: ");
-        juce::Logger::writeToLog (command.describe ());
+        return false;
     }
 
-    void logResponse (const Response & response)
+    [[nodiscard]] PendingResponse::Sender
+    createSender (const Command & command,
+                  CommandTiming timing,
+                  std::shared_ptr<LocalResponse> localResponse) const
     {
-        if (_logLevel == LogLevel::silent)
-            return;
+        return [logLevel = _logLevel,
+                weakConnection = std::weak_ptr<Connection> (_connection),
+                metrics = _metrics,
+                allocationTracker = _allocationTracker,
+                recorder = _recorder,
+                commandType = command.getType (),
+                timing,
+                localResponse = std::move (localResponse),
+                handlerStartMs = juce::Time::getMillisecondCounterHiRes ()] (
+                   auto && response) mutable
+        {
+            const AllocationTracker::ScopedOwner owner (AllocationTracker::Owner::library);
+            const AllocationTracker::ScopedCommand allocations (*allocationTracker, commandType);
+
+            logResponse (logLevel, response);
 
-        juce::Logger::writeToLog ("Sending response: ");
-        juce::Logger::writeToLog (response.describe ());
+            if (localResponse)
+            {
+                timing.handlerMs = juce::Time::getMillisecondCounterHiRes () - handlerStartMs;
+                localResponse->set (response);
+                metrics->record (commandType, timing);
+                return;
+            }
+
+            const ScratchArena::Scope scratch;
+
+            const auto serializeStartMs = juce::Time::getMillisecondCounterHiRes ();
+            ScratchArena::OutputStream json;
+            response.writeJson (json);
+            const auto writeStartMs = juce::Time::getMillisecondCounterHiRes ();
+
+            if (auto connection = weakConnection.lock ())
+                send (connection.get (), json.getData (), json.getDataSize ());
+
+            record (
+                recorder.get (), SessionLog::Kind::response, json.getData (), json.getDataSize ());
+
+            timing.handlerMs = serializeStartMs - handlerStartMs;
+            timing.serializeMs = writeStartMs - serializeStartMs;
+            timing.writeMs = juce::Time::getMillisecondCounterHiRes () - writeStartMs;
+            metrics->record (commandType, timing);
+        };
     }
 
+    struct QueuedCommand
+    {
+        Command command;
+        CommandTiming timing;
+        std::shared_ptr<LocalResponse> localResponse;
+        double postedMs = 0.0;
+    };
+
+    static constexpr auto commandQueueCapacity = 64;
+
+    const juce::int64 _createdMs = juce::Time::currentTimeMillis ();
     const LogLevel _logLevel;
 
+    CommandParser _parser;
     DefaultCommandHandler _defaultCommandHandler;
+    juce::ReadWriteLock _commandHandlersLock;
     std::vector<std::reference_wrapper<CommandHandler>> _commandHandlers;
+    std::vector<std::reference_wrapper<AsyncCommandHandler>> _asyncCommandHandlers;
+    std::vector<const void *> _builtInHandlers;
+    ResponseDeadlines _responseDeadlines;
+    std::shared_ptr<CommandMetrics> _metrics = std::make_shared<CommandMetrics> ();
+    std::shared_ptr<AllocationTracker> _allocationTracker = std::make_shared<AllocationTracker> ();
+    std::shared_ptr<SessionLogWriter> _recorder;
     std::shared_ptr<Connection> _connection;
+    EventThrottle _eventThrottle {[this] (auto && event)
+                                  {
+                                      const auto json = event.toJson ();
+                                      send (_connection.get (), json);
+                                      record (_recorder.get (), SessionLog::Kind::event, json);
+                                  }};
+    FrameCapture _frameCapture {*this};
+    TextTyper _textTyper;
+    MouseGesture _mouseGesture;
+    ScriptRunner _scriptRunner {*this};
+    IdleDetector _idleDetector;
+    PaintProfiler _paintProfiler;
+    MemoryStats _memoryStats;
+    TimeSource _timeSource;
+    VirtualClock _virtualClock {_timeSource,
+                                getCommandLineOption ("--e2e-virtual-time").has_value ()};
+    AppMetrics _appMetrics {*this};
+    RealtimeEventWriter _realtimeEventWriter {*this};
+    std::unique_ptr<StallMonitor> _stallMonitor;
+    std::unique_ptr<ReplayThread> _replayThread;
+    MessageThreadQueue<QueuedCommand> _commandQueue {
+        commandQueueCapacity,
+        [this] (auto && queued)
+        {
+            queued.timing.queuedMs = juce::Time::getMillisecondCounterHiRes () - queued.postedMs;
+            processOnMessageThread (queued.command, queued.timing, queued.localResponse);
+        }};
 };
 
 std::unique_ptr<TestCentre> TestCentre::create (LogLevel logLevel)
 {
-    return std::make_unique<E2ETestCentre> (logLevel);
+    return std::make_unique<E2ETestCentre> (logLevel, getPort ());
+}
+
+std::unique_ptr<TestCentre> createConnectedTestCentre (int port, TestCentre::LogLevel logLevel)
+{
+    return std::make_unique<E2ETestCentre> (logLevel, port);
 }
 
 }
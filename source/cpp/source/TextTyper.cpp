@@ -0,0 +1,195 @@
+#include "TextTyper.h"
+
+#include "AllocationTracker.h"
+#include "KeyPress.h"
+
+#include <focusrite/e2e/ComponentSearch.h>
+
+namespace focusrite::e2e
+{
+static constexpr auto maxDelayMs = 10'000;
+
+enum class TypingMethod
+{
+    keyPress,
+    insert,
+};
+
+[[nodiscard]] static int getDelayMs (const Command & command)
+{
+    return juce::jlimit (0, maxDelayMs, int (command.getArgumentAsVar ("delay-ms")));
+}
+
+class TextTyper::Typing final : private juce::Timer
+{
+public:
+    Typing (juce::Component & target,
+            TypingMethod method,
+            juce::String text,
+            int delayMs,
+            std::shared_ptr<Responder> responder)
+        : _target (&target)
+        , _method (method)
+        , _text (std::move (text))
+        , _next (_text.getCharPointer ())
+        , _delayMs (delayMs)
+        , _responder (std::move (responder))
+        , _startMs (juce::Time::getMillisecondCounterHiRes ())
+    {
+    }
+
+    void start ()
+    {
+        if (_delayMs > 0)
+        {
+            typeNextCharacter ();
+
+            if (! isFinished ())
+                startTimer (_delayMs);
+
+            return;
+        }
+
+        if (_method == TypingMethod::insert)
+        {
+            insert (_text);
+            _numTyped = _text.length ();
+            _next = _next.findTerminatingNull ();
+        }
+
+        while (! isFinished ())
+            typeNextCharacter ();
+    }
+
+    [[nodiscard]] bool isFinished () const
+    {
+        return _responder->hasResponded ();
+    }
+
+private:
+    void timerCallback () override
+    {
+        typeNextCharacter ();
+
+        if (isFinished ())
+            stopTimer ();
+    }
+
+    void typeNextCharacter ()
+    {
+        if (_target == nullptr)
+        {
+            _responder->respond (Response::fail ("Component deleted while typing"));
+            return;
+        }
+
+        if (! _next.isEmpty ())
+        {
+            const auto character = _next.getAndAdvance ();
+            ++_numTyped;
+
+            if (_method == TypingMethod::insert)
+                insert (juce::String::charToString (character));
+            else
+                pressKey (constructKeyPress (character));
+        }
+
+        if (_next.isEmpty ())
+            _responder->respond (
+                Response::ok ()
+                    .withParameter ("typed", _numTyped)
+                    .withParameter ("duration-ms",
+                                    juce::Time::getMillisecondCounterHiRes () - _startMs));
+    }
+
+    void insert (const juce::String & text)
+    {
+        const AllocationTracker::ScopedOwner owner (AllocationTracker::Owner::app);
+
+        if (auto * editor = dynamic_cast<juce::TextEditor *> (_target.getComponent ()))
+            editor->insertTextAtCaret (text);
+    }
+
+    void pressKey (const juce::KeyPress & keyPress)
+    {
+        const AllocationTracker::ScopedOwner owner (AllocationTracker::Owner::app);
+
+        // A window is typed into through its peer, so the key reaches the focused component
+        // just as a real key press would
+        if (auto * window = dynamic_cast<juce::TopLevelWindow *> (_target.getComponent ()))
+            if (auto * peer = window->getPeer ())
+            {
+                peer->handleKeyPress (keyPress);
+                return;
+            }
+
+        _target->keyPressed (keyPress);
+    }
+
+    juce::Component::SafePointer<juce::Component> _target;
+    const TypingMethod _method;
+    const juce::String _text;
+    juce::String::CharPointerType _next;
+    const int _delayMs;
+    const std::shared_ptr<Responder> _responder;
+    const double _startMs;
+    int _numTyped = 0;
+};
+
+TextTyper::TextTyper () = default;
+TextTyper::~TextTyper () = default;
+
+bool TextTyper::process (const Command & command, std::shared_ptr<Responder> responder)
+{
+    if (command.getType () != "type-text")
+        return false;
+
+    _typings.erase (std::remove_if (_typings.begin (),
+                                    _typings.end (),
+                                    [] (auto && typing) { return typing->isFinished (); }),
+                    _typings.end ());
+
+    const auto text = command.getArgument ("text");
+    const auto componentId = command.getArgument ("component-id");
+    const auto method = command.getArgument ("method") == "insert" ? TypingMethod::insert
+                                                                    : TypingMethod::keyPress;
+
+    juce::Component * target = nullptr;
+
+    if (componentId.isNotEmpty ())
+        target = ComponentSearch::findWithId (componentId);
+    else if (method == TypingMethod::insert)
+        target = juce::Component::getCurrentlyFocusedComponent ();
+    else
+        target = ComponentSearch::findWindowWithId (command.getArgument ("window-id"));
+
+    if (target == nullptr)
+    {
+        responder->respond (Response::fail (componentId.isEmpty ()
+                                                ? "Nothing to type into"
+                                                : "Component not found for typing: " +
+                                                      componentId));
+        return true;
+    }
+
+    if (method == TypingMethod::insert && dynamic_cast<juce::TextEditor *> (target) == nullptr)
+    {
+        responder->respond (Response::fail ("Can only insert text into a TextEditor"));
+        return true;
+    }
+
+    auto & typing = *_typings.emplace_back (
+        std::make_unique<Typing> (*target, method, text, getDelayMs (command), responder));
+    typing.start ();
+
+    return true;
+}
+
+juce::RelativeTime TextTyper::getTimeout (const Command & command) const
+{
+    return AsyncCommandHandler::getTimeout (command) +
+           juce::RelativeTime::milliseconds (
+               juce::int64 (getDelayMs (command)) * command.getArgument ("text").length ());
+}
+
+}
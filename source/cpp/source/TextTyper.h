@@ -0,0 +1,28 @@
+#pragma once
+
+#include <focusrite/e2e/AsyncCommandHandler.h>
+#include <juce_gui_basics/juce_gui_basics.h>
+
+namespace focusrite::e2e
+{
+// Handles type-text: types a whole string into a component or window in one command, either
+// as key presses or by inserting into a TextEditor, optionally pausing between characters
+class TextTyper final : public AsyncCommandHandler
+{
+public:
+    TextTyper ();
+    ~TextTyper () override;
+
+    TextTyper (const TextTyper &) = delete;
+    TextTyper & operator= (const TextTyper &) = delete;
+
+    bool process (const Command & command, std::shared_ptr<Responder> responder) override;
+    [[nodiscard]] juce::RelativeTime getTimeout (const Command & command) const override;
+
+private:
+    class Typing;
+
+    std::vector<std::unique_ptr<Typing>> _typings;
+};
+
+}
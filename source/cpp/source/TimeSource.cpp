@@ -0,0 +1,72 @@
+#include <focusrite/e2e/TimeSource.h>
+
+namespace focusrite::e2e
+{
+TimeSource::TimeSource () noexcept
+    : _realMs (juce::Time::getMillisecondCounterHiRes ())
+    , _virtualMs (_realMs.load ())
+{
+}
+
+double TimeSource::getMillisecondCounterHiRes () const noexcept
+{
+    return toVirtualMs (read (), juce::Time::getMillisecondCounterHiRes ());
+}
+
+double TimeSource::getScale () const noexcept
+{
+    return read ().scale;
+}
+
+void TimeSource::setScale (double scale) noexcept
+{
+    const juce::SpinLock::ScopedLockType lock (_writeLock);
+
+    const auto realMs = juce::Time::getMillisecondCounterHiRes ();
+    write ({realMs, toVirtualMs (read (), realMs), std::max (0.0, scale)});
+}
+
+void TimeSource::advance (double milliseconds) noexcept
+{
+    const juce::SpinLock::ScopedLockType lock (_writeLock);
+
+    auto anchor = read ();
+    anchor.virtualMs += std::max (0.0, milliseconds);
+    write (anchor);
+}
+
+TimeSource::Anchor TimeSource::read () const noexcept
+{
+    for (;;)
+    {
+        const auto version = _version.load (std::memory_order_acquire);
+
+        const Anchor anchor {_realMs.load (std::memory_order_relaxed),
+                             _virtualMs.load (std::memory_order_relaxed),
+                             _scale.load (std::memory_order_relaxed)};
+
+        std::atomic_thread_fence (std::memory_order_acquire);
+
+        if ((version & 1) == 0 && _version.load (std::memory_order_relaxed) == version)
+            return anchor;
+    }
+}
+
+double TimeSource::toVirtualMs (const Anchor & anchor, double realMs) noexcept
+{
+    return anchor.virtualMs + (realMs - anchor.realMs) * anchor.scale;
+}
+
+void TimeSource::write (const Anchor & anchor) noexcept
+{
+    _version.fetch_add (1, std::memory_order_relaxed);
+    std::atomic_thread_fence (std::memory_order_release);
+
+    _realMs.store (anchor.realMs, std::memory_order_relaxed);
+    _virtualMs.store (anchor.virtualMs, std::memory_order_relaxed);
+    _scale.store (anchor.scale, std::memory_order_relaxed);
+
+    _version.fetch_add (1, std::memory_order_release);
+}
+
+}
@@ -0,0 +1,294 @@
+#include "Tracer.h"
+
+#include <focusrite/e2e/Trace.h>
+#include <juce_events/juce_events.h>
+#include <cstdio>
+#include <mutex>
+#include <set>
+#include <vector>
+
+namespace focusrite::e2e
+{
+static constexpr size_t eventsPerThread = 1 << 16;
+static constexpr int maxThreads = 16;
+
+// Left uninitialised so that the pages of a buffer are only touched once its thread uses them
+struct TraceEvent
+{
+    const char * name;
+    const char * detail;
+    juce::int64 ticks;
+    bool isBegin;
+};
+
+// A ring written only by the thread that claimed it, keeping its latest events. The total count is
+// published with release ordering so that flush () can copy the events without locking.
+struct ThreadBuffer
+{
+    char threadName [64] {};
+    std::atomic<bool> claimed {false};
+    std::unique_ptr<TraceEvent []> events {new TraceEvent [eventsPerThread]};
+    std::atomic<size_t> numEvents {0};
+};
+
+// The buffers are allocated by Tracer::start (), so recording never locks or allocates. Writers
+// are counted so that Tracer::stop () can wait for them before releasing the buffers.
+struct TraceState
+{
+    std::atomic<bool> enabled {false};
+    std::atomic<int> numWriters {0};
+    std::atomic<int> generation {0};
+    juce::int64 startTicks = 0;
+    juce::File file;
+
+    std::mutex buffersMutex;
+    std::unique_ptr<ThreadBuffer []> buffers;
+    std::atomic<int> numClaimedBuffers {0};
+
+    std::mutex internMutex;
+    std::set<std::string> internedStrings;
+};
+
+[[nodiscard]] static TraceState & getState ()
+{
+    static TraceState state;
+    return state;
+}
+
+static void copyCurrentThreadName (ThreadBuffer & buffer, int threadIndex) noexcept
+{
+    auto * name = buffer.threadName;
+    const auto maxBytes = sizeof (buffer.threadName);
+
+    if (juce::MessageManager::existsAndIsCurrentThread ())
+        std::snprintf (name, maxBytes, "Message thread");
+    else if (auto * thread = juce::Thread::getCurrentThread ())
+        thread->getThreadName ().copyToUTF8 (name, maxBytes);
+
+    if (name [0] == 0)
+        std::snprintf (name, maxBytes, "Thread %d", threadIndex);
+}
+
+// Returns nullptr once every buffer has been claimed by another thread
+[[nodiscard]] static ThreadBuffer * getThreadBuffer (TraceState & state) noexcept
+{
+    thread_local int bufferGeneration = 0;
+    thread_local ThreadBuffer * buffer = nullptr;
+
+    if (const auto generation = state.generation.load (); bufferGeneration != generation)
+    {
+        bufferGeneration = generation;
+        buffer = nullptr;
+
+        if (const auto index = state.numClaimedBuffers.fetch_add (1); index < maxThreads)
+        {
+            buffer = &state.buffers [size_t (index)];
+            copyCurrentThreadName (*buffer, index + 1);
+            buffer->claimed.store (true, std::memory_order_release);
+        }
+    }
+
+    return buffer;
+}
+
+static void record (const char * name, const char * detail, bool isBegin) noexcept
+{
+    auto & state = getState ();
+    ++state.numWriters;
+
+    if (state.enabled)
+    {
+        if (auto * buffer = getThreadBuffer (state))
+        {
+            const auto index = buffer->numEvents.load (std::memory_order_relaxed);
+            buffer->events [index % eventsPerThread] = {
+                name, detail, juce::Time::getHighResolutionTicks (), isBegin};
+            buffer->numEvents.store (index + 1, std::memory_order_release);
+        }
+    }
+
+    --state.numWriters;
+}
+
+bool Trace::isEnabled () noexcept
+{
+    return getState ().enabled.load (std::memory_order_relaxed);
+}
+
+void Trace::begin (const char * name, const char * detail) noexcept
+{
+    if (isEnabled ())
+        record (name, detail, true);
+}
+
+void Trace::end () noexcept
+{
+    if (isEnabled ())
+        record (nullptr, nullptr, false);
+}
+
+ScopedTrace::ScopedTrace (const char * name, const char * detail) noexcept
+    : _enabled (Trace::isEnabled ())
+{
+    if (_enabled)
+        record (name, detail, true);
+}
+
+ScopedTrace::~ScopedTrace ()
+{
+    if (_enabled)
+        record (nullptr, nullptr, false);
+}
+
+void Tracer::start (const juce::File & file)
+{
+    stop ();
+
+    auto & state = getState ();
+    const std::lock_guard lock (state.buffersMutex);
+
+    state.file = file;
+    state.startTicks = juce::Time::getHighResolutionTicks ();
+    state.buffers = std::make_unique<ThreadBuffer []> (maxThreads);
+    state.numClaimedBuffers = 0;
+    ++state.generation;
+    state.enabled = true;
+}
+
+void Tracer::stop ()
+{
+    auto & state = getState ();
+    const std::lock_guard lock (state.buffersMutex);
+
+    if (! state.enabled.exchange (false))
+        return;
+
+    // A thread that started recording before tracing was disabled may still be writing
+    while (state.numWriters != 0)
+        juce::Thread::yield ();
+
+    state.buffers.reset ();
+}
+
+juce::File Tracer::getFile ()
+{
+    return getState ().file;
+}
+
+const char * Tracer::intern (const juce::String & text)
+{
+    auto & state = getState ();
+    const std::lock_guard lock (state.internMutex);
+    return state.internedStrings.insert (text.toStdString ()).first->c_str ();
+}
+
+[[nodiscard]] static juce::String quote (const char * text)
+{
+    return juce::JSON::toString (juce::String (text));
+}
+
+// The index of the oldest event that the thread can't have started overwriting
+[[nodiscard]] static size_t getOldestIntactIndex (size_t numEvents)
+{
+    return numEvents < eventsPerThread ? 0 : numEvents - eventsPerThread + 1;
+}
+
+static void writeThreadEvents (juce::OutputStream & stream,
+                               const ThreadBuffer & buffer,
+                               int threadIndex,
+                               juce::int64 startTicks,
+                               bool & first)
+{
+    const auto writeSeparator = [&]
+    {
+        stream << (first ? "\n" : ",\n");
+        first = false;
+    };
+
+    // The thread keeps recording while its events are copied, so any that it may have overwritten
+    // in the meantime are discarded afterwards
+    const auto numEvents = buffer.numEvents.load (std::memory_order_acquire);
+    const auto firstIndex = getOldestIntactIndex (numEvents);
+
+    std::vector<TraceEvent> events;
+    events.reserve (numEvents - firstIndex);
+
+    for (auto index = firstIndex; index < numEvents; ++index)
+        events.push_back (buffer.events [index % eventsPerThread]);
+
+    std::atomic_thread_fence (std::memory_order_acquire);
+    const auto firstIntactIndex = juce::jmax (
+        firstIndex, getOldestIntactIndex (buffer.numEvents.load (std::memory_order_relaxed)));
+    const auto numSkipped = firstIntactIndex - firstIndex;
+
+    const auto tid = juce::String (threadIndex);
+
+    writeSeparator ();
+    stream << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << tid << R"(,"args":{"name":)"
+           << juce::JSON::toString (juce::String::fromUTF8 (buffer.threadName))
+           << R"(,"dropped":)" << juce::String (juce::uint64 (firstIntactIndex)) << "}}";
+
+    // Ends whose begin was overwritten are left out, so that every span written is balanced
+    auto depth = 0;
+
+    for (auto index = numSkipped; index < events.size (); ++index)
+    {
+        const auto & event = events [index];
+
+        if (! event.isBegin && depth == 0)
+            continue;
+
+        depth += event.isBegin ? 1 : -1;
+
+        const auto microseconds =
+            juce::Time::highResolutionTicksToSeconds (event.ticks - startTicks) * 1.0e6;
+
+        writeSeparator ();
+        stream << R"({"ph":")" << (event.isBegin ? "B" : "E") << R"(","pid":1,"tid":)" << tid
+               << R"(,"ts":)" << juce::String (microseconds, 3);
+
+        if (event.name != nullptr)
+            stream << R"(,"name":)" << quote (event.name);
+
+        if (event.detail != nullptr)
+            stream << R"(,"args":{"detail":)" << quote (event.detail) << "}";
+
+        stream << "}";
+    }
+}
+
+juce::Result Tracer::flush ()
+{
+    auto & state = getState ();
+    const std::lock_guard lock (state.buffersMutex);
+
+    if (! state.enabled)
+        return juce::Result::fail ("Tracing is not enabled");
+
+    juce::FileOutputStream stream (state.file);
+    if (! stream.openedOk ())
+        return juce::Result::fail ("Could not open " + state.file.getFullPathName ());
+
+    stream.setPosition (0);
+    stream.truncate ();
+
+    stream << R"({"displayTimeUnit":"ms","traceEvents":[)";
+
+    const auto numBuffers = juce::jmin (state.numClaimedBuffers.load (), maxThreads);
+    auto first = true;
+
+    for (auto index = 0; index < numBuffers; ++index)
+    {
+        const auto & buffer = state.buffers [size_t (index)];
+
+        if (buffer.claimed.load (std::memory_order_acquire))
+            writeThreadEvents (stream, buffer, index + 1, state.startTicks, first);
+    }
+
+    stream << "\n]}\n";
+    stream.flush ();
+
+    return stream.getStatus ();
+}
+
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+namespace focusrite::e2e
+{
+class Tracer
+{
+public:
+    static void start (const juce::File & file);
+
+    // Disables tracing and releases the buffers, discarding anything that hasn't been flushed
+    static void stop ();
+
+    [[nodiscard]] static juce::Result flush ();
+    [[nodiscard]] static juce::File getFile ();
+
+    // Returns a pointer that stays valid for the lifetime of the process, for use as a detail
+    [[nodiscard]] static const char * intern (const juce::String & text);
+};
+
+}
@@ -0,0 +1,64 @@
+#include "VirtualClock.h"
+
+namespace focusrite::e2e
+{
+VirtualClock::VirtualClock (TimeSource & timeSource, bool enabled)
+    : _timeSource (timeSource)
+    , _enabled (enabled)
+{
+}
+
+std::optional<Response> VirtualClock::process (const Command & command)
+{
+    const auto type = command.getType ();
+
+    if (type != "advance-time" && type != "set-time-scale")
+        return std::nullopt;
+
+    if (! _enabled)
+        return Response::fail ("Virtual time is disabled, launch the app with --e2e-virtual-time");
+
+    return type == "advance-time" ? advanceTime (command) : setTimeScale (command);
+}
+
+CommandHandler::ThreadAffinity VirtualClock::getThreadAffinity (const Command & command) const
+{
+    juce::ignoreUnused (command);
+    return ThreadAffinity::anyThread;
+}
+
+Response VirtualClock::advanceTime (const Command & command)
+{
+    const auto milliseconds = command.getArgumentAsVar ("ms");
+
+    if (! milliseconds.isDouble () && ! milliseconds.isInt () && ! milliseconds.isInt64 ())
+        return Response::fail ("Missing ms");
+
+    if (double (milliseconds) < 0.0)
+        return Response::fail ("Time can't go backwards");
+
+    _timeSource.advance (milliseconds);
+    return withTime (Response::ok ());
+}
+
+Response VirtualClock::setTimeScale (const Command & command)
+{
+    const auto scale = command.getArgumentAsVar ("scale");
+
+    if (! scale.isDouble () && ! scale.isInt () && ! scale.isInt64 ())
+        return Response::fail ("Missing scale");
+
+    if (double (scale) < 0.0)
+        return Response::fail ("Time scale can't be negative");
+
+    _timeSource.setScale (scale);
+    return withTime (Response::ok ());
+}
+
+Response VirtualClock::withTime (const Response & response) const
+{
+    return response.withParameter ("time-ms", _timeSource.getMillisecondCounterHiRes ())
+        .withParameter ("scale", _timeSource.getScale ());
+}
+
+}
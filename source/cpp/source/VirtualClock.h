@@ -0,0 +1,27 @@
+#pragma once
+
+#include <focusrite/e2e/CommandHandler.h>
+#include <focusrite/e2e/TimeSource.h>
+
+namespace focusrite::e2e
+{
+// Handles advance-time and set-time-scale, which control the TestCentre's time source when
+// virtual time is enabled
+class VirtualClock final : public CommandHandler
+{
+public:
+    VirtualClock (TimeSource & timeSource, bool enabled);
+
+    std::optional<Response> process (const Command & command) override;
+    [[nodiscard]] ThreadAffinity getThreadAffinity (const Command & command) const override;
+
+private:
+    [[nodiscard]] Response advanceTime (const Command & command);
+    [[nodiscard]] Response setTimeScale (const Command & command);
+    [[nodiscard]] Response withTime (const Response & response) const;
+
+    TimeSource & _timeSource;
+    const bool _enabled;
+};
+
+}
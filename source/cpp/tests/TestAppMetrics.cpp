@@ -0,0 +1,158 @@
+#include "TestHelpers.h"
+
+#include <focusrite/e2e/TestCentre.h>
+#include <juce_events/juce_events.h>
+#include <thread>
+
+namespace focusrite::e2e
+{
+class AppMetricsTests final : public juce::UnitTest
+{
+public:
+    AppMetricsTests () noexcept
+        : juce::UnitTest ("AppMetrics")
+    {
+    }
+
+    void runTest () override
+    {
+        struct Test
+        {
+            juce::String name;
+            std::function<void ()> entry;
+        };
+
+        auto tests = {
+            Test {"Names refer to the same metric", [this] { namesReferToSameMetric (); }},
+            Test {"Counters add up across threads", [this] { countersAddUpAcrossThreads (); }},
+            Test {"Gauges keep the latest value", [this] { gaugesKeepLatestValue (); }},
+            Test {"Histograms summarise their values", [this] { histogramsSummarise (); }},
+            Test {"Validates the sampling interval", [this] { validatesInterval (); }},
+        };
+
+        for (auto && test : tests)
+        {
+            beginTest (test.name);
+            test.entry ();
+        }
+    }
+
+    void namesReferToSameMetric ()
+    {
+        auto testCentre = create ();
+
+        expect (&testCentre->getCounter ("voices") == &testCentre->getCounter ("voices"));
+        expect (&testCentre->getCounter ("voices") != &testCentre->getCounter ("notes"));
+        expect (&testCentre->getGauge ("cpu") == &testCentre->getGauge ("cpu"));
+        expect (&testCentre->getHistogram ("block") == &testCentre->getHistogram ("block"));
+
+        destroy (testCentre);
+    }
+
+    void countersAddUpAcrossThreads ()
+    {
+        static constexpr auto numThreads = 4;
+        static constexpr auto numIncrements = 10'000;
+
+        auto testCentre = create ();
+        auto & counter = testCentre->getCounter ("events");
+
+        std::vector<std::thread> threads;
+        for (auto thread = 0; thread < numThreads; ++thread)
+            threads.emplace_back (
+                [&]
+                {
+                    for (auto increment = 0; increment < numIncrements; ++increment)
+                        counter.increment ();
+                });
+
+        for (auto & thread : threads)
+            thread.join ();
+
+        counter.increment (5);
+
+        expectEquals (counter.getValue (), juce::int64 (numThreads * numIncrements + 5));
+        expectEquals (int (getMetrics (*testCentre) ["counters"]["events"]),
+                      numThreads * numIncrements + 5);
+
+        destroy (testCentre);
+    }
+
+    void gaugesKeepLatestValue ()
+    {
+        auto testCentre = create ();
+        auto & gauge = testCentre->getGauge ("cpu");
+
+        gauge.set (0.25);
+        gauge.set (0.75);
+
+        expectEquals (gauge.getValue (), 0.75);
+        expectEquals (double (getMetrics (*testCentre) ["gauges"]["cpu"]), 0.75);
+
+        destroy (testCentre);
+    }
+
+    void histogramsSummarise ()
+    {
+        auto testCentre = create ();
+        auto & histogram = testCentre->getHistogram ("voices");
+
+        for (uint64_t value = 1; value <= 10; ++value)
+            histogram.record (value);
+
+        expectEquals (histogram.getCount (), uint64_t (10));
+
+        const auto summary = getMetrics (*testCentre) ["histograms"]["voices"];
+        expectEquals (int (summary ["count"]), 10);
+        expectEquals (int (summary ["max"]), 10);
+        expectEquals (double (summary ["mean"]), 5.5);
+        expectEquals (int (summary ["p50"]), 5);
+
+        destroy (testCentre);
+    }
+
+    void validatesInterval ()
+    {
+        auto testCentre = create ();
+
+        const auto setInterval = [&] (int intervalMs)
+        {
+            auto args = std::make_unique<juce::DynamicObject> ();
+            args->setProperty ("interval-ms", intervalMs);
+
+            return testCentre
+                ->submit (Command::create ("set-app-metrics-interval", args.release ()))
+                .get ();
+        };
+
+        expect (setInterval (-1).getResult ().failed ());
+        expectEquals (int (setInterval (1).getParameter ("interval-ms")), 10);
+        expectEquals (int (setInterval (250).getParameter ("interval-ms")), 250);
+        expectEquals (int (setInterval (0).getParameter ("interval-ms")), 0);
+
+        destroy (testCentre);
+    }
+
+private:
+    [[nodiscard]] static std::unique_ptr<TestCentre> create ()
+    {
+        return runOnMessageQueue ([] { return TestCentre::create (); });
+    }
+
+    static void destroy (std::unique_ptr<TestCentre> & testCentre)
+    {
+        runOnMessageQueue ([&] { testCentre.reset (); });
+    }
+
+    // get-app-metrics can be answered on any thread, so it's answered before submit returns
+    [[nodiscard]] static juce::var getMetrics (TestCentre & testCentre)
+    {
+        return testCentre.submit (Command::create ("get-app-metrics"))
+            .get ()
+            .getParameter ("metrics");
+    }
+};
+
+[[maybe_unused]] static AppMetricsTests appMetricsTests;
+
+}
@@ -0,0 +1,138 @@
+#include "../source/CommandMetrics.h"
+#include "TestHelpers.h"
+
+#include <focusrite/e2e/TestCentre.h>
+
+namespace focusrite::e2e
+{
+class CommandMetricsTests final : public juce::UnitTest
+{
+public:
+    CommandMetricsTests () noexcept
+        : juce::UnitTest ("CommandMetrics")
+    {
+    }
+
+    void runTest () override
+    {
+        struct Test
+        {
+            juce::String name;
+            std::function<void ()> entry;
+        };
+
+        auto tests = {
+            Test {"Records each phase separately", [this] { recordsEachPhase (); }},
+            Test {"Keeps command types apart", [this] { keepsCommandTypesApart (); }},
+            Test {"Reset omits idle commands", [this] { resetOmitsIdleCommands (); }},
+            Test {"Nested searches are timed once", [this] { nestedSearchesTimedOnce (); }},
+            Test {"get-metrics reports handled commands", [this] { getMetricsReports (); }},
+        };
+
+        for (auto && test : tests)
+        {
+            beginTest (test.name);
+            test.entry ();
+        }
+    }
+
+    void recordsEachPhase ()
+    {
+        CommandMetrics metrics;
+        metrics.record ("click", createTiming ());
+        metrics.record ("click", createTiming ());
+
+        const auto click = metrics.toVar () ["click"];
+        expectEquals (int (click ["count"]), 2);
+
+        auto expectedMaxUs = 1000;
+        for (const auto * phase : {"read", "queued", "search", "handler", "serialize", "write"})
+        {
+            expectEquals (int (click [phase]["count"]), 2);
+            expectEquals (int (click [phase]["max"]), expectedMaxUs);
+            expectedMaxUs += 1000;
+        }
+    }
+
+    void keepsCommandTypesApart ()
+    {
+        CommandMetrics metrics;
+        metrics.record ("click", createTiming ());
+        metrics.record ("click", createTiming ());
+        metrics.record ("key-press", createTiming ());
+
+        const auto commands = metrics.toVar ();
+        expectEquals (int (commands ["click"]["count"]), 2);
+        expectEquals (int (commands ["key-press"]["count"]), 1);
+    }
+
+    void resetOmitsIdleCommands ()
+    {
+        CommandMetrics metrics;
+        metrics.record ("click", createTiming ());
+        metrics.reset ();
+        metrics.record ("key-press", createTiming ());
+
+        const auto commands = metrics.toVar ();
+        expect (! commands.hasProperty ("click"));
+        expectEquals (int (commands ["key-press"]["count"]), 1);
+
+        expect (metrics.process (Command::create ("reset-metrics")).has_value ());
+        expect (! metrics.toVar ().hasProperty ("key-press"));
+    }
+
+    void nestedSearchesTimedOnce ()
+    {
+        static constexpr auto searchMs = 50;
+
+        juce::ignoreUnused (ScopedSearchTimer::takeElapsedMs ());
+
+        {
+            const ScopedSearchTimer outer;
+            const ScopedSearchTimer inner;
+            juce::Thread::sleep (searchMs);
+        }
+
+        const auto elapsedMs = ScopedSearchTimer::takeElapsedMs ();
+        expectGreaterOrEqual (elapsedMs, double (searchMs));
+        expectLessThan (elapsedMs, double (searchMs * 2));
+        expectEquals (ScopedSearchTimer::takeElapsedMs (), 0.0);
+    }
+
+    // Each command is recorded once it has been answered, so the second get-metrics sees the first
+    void getMetricsReports ()
+    {
+        const auto commands = runOnMessageQueue (
+            [&]
+            {
+                auto testCentre = TestCentre::create ();
+                juce::ignoreUnused (testCentre->submit (Command::create ("get-metrics")).get ());
+                return testCentre->submit (Command::create ("get-metrics"))
+                    .get ()
+                    .getParameter ("commands");
+            });
+
+        const auto getMetrics = commands ["get-metrics"];
+        expectEquals (int (getMetrics ["count"]), 1);
+
+        for (const auto * phase : {"read", "queued", "search", "handler", "serialize", "write"})
+            expect (getMetrics [phase].hasProperty ("p99"));
+    }
+
+private:
+    [[nodiscard]] static CommandTiming createTiming ()
+    {
+        CommandTiming timing;
+        timing.readMs = 1.0;
+        timing.queuedMs = 2.0;
+        timing.searchMs = 3.0;
+        timing.handlerMs = 4.0;
+        timing.serializeMs = 5.0;
+        timing.writeMs = 6.0;
+        return timing;
+    }
+};
+
+[[maybe_unused]] static CommandMetricsTests commandMetricsTests;
+
+}
@@ -1,24 +1,11 @@
+#include "TestHelpers.h"
+
 #include <focusrite/e2e/ComponentSearch.h>
 #include <future>
 #include <juce_core/juce_core.h>
 
 namespace focusrite::e2e
 {
-template <typename Task>
-void runOnMessageQueue (Task task)
-{
-    juce::WaitableEvent event;
-
-    juce::MessageManager::callAsync (
-        [&]
-        {
-            task ();
-            event.signal ();
-        });
-
-    event.wait ();
-}
-
 class ComponentSearchTests final : public juce::UnitTest
 {
 public:
@@ -40,6 +27,7 @@ public:
             Test {"Finds component with test ID", [=] { findsComponentWithTestId (); }},
             Test {"Finds nested components with slashes",
                   [=] { findsNestedComponentsWithSlashes (); }},
+            Test {"Skips matches in search order", [=] { skipsMatchesInSearchOrder (); }},
         };
 
         for (auto && test : tests)
@@ -146,6 +134,33 @@ public:
         expect (ComponentSearch::findWithId ("component-a/component-c/*") == &genericC);
         expect (ComponentSearch::findWithId ("component-a/*/generic") == &genericB);
     }
+
+    // Matching children come before their descendants, whether matched by test ID or component ID
+    void skipsMatchesInSearchOrder ()
+    {
+        constexpr auto id = "match";
+
+        juce::TopLevelWindow window ("window", true);
+        juce::Component first;
+        juce::Component parent;
+        juce::Component nested;
+        juce::Component last;
+
+        ComponentSearch::setTestId (first, id);
+        ComponentSearch::setTestId (nested, id);
+        last.setComponentID (id);
+
+        parent.addAndMakeVisible (nested);
+        window.addAndMakeVisible (first);
+        window.addAndMakeVisible (parent);
+        window.addAndMakeVisible (last);
+        window.setVisible (true);
+
+        expect (ComponentSearch::findWithId (id) == &first);
+        expect (ComponentSearch::findWithId (id, 1) == &last);
+        expect (ComponentSearch::findWithId (id, 2) == &nested);
+        expect (ComponentSearch::findWithId (id, 3) == nullptr);
+    }
 };
 
 [[maybe_unused]] static ComponentSearchTests componentSearchTests;
@@ -0,0 +1,168 @@
+#include "../source/EventThrottle.h"
+
+namespace focusrite::e2e
+{
+static const auto longInterval = juce::RelativeTime::hours (1.0);
+
+class EventThrottleTests final : public juce::UnitTest
+{
+public:
+    EventThrottleTests () noexcept
+        : juce::UnitTest ("EventThrottle")
+    {
+    }
+
+    void runTest () override
+    {
+        struct Test
+        {
+            juce::String name;
+            std::function<void ()> entry;
+        };
+
+        auto tests = {
+            Test {"Events without a policy are sent", [this] { unthrottledEventsAreSent (); }},
+            Test {"Keep latest coalesces events", [this] { keepLatestCoalesces (); }},
+            Test {"Batch collects events", [this] { batchCollectsEvents (); }},
+            Test {"Policies only apply to their event", [this] { policiesApplyByName (); }},
+            Test {"Stopping sends pending events", [this] { stoppingSendsPendingEvents (); }},
+            Test {"Destruction sends pending events", [this] { destructionSendsPendingEvents (); }},
+            Test {"Library events can't be throttled", [this] { libraryEventsAreReserved (); }},
+        };
+
+        for (auto && test : tests)
+        {
+            beginTest (test.name);
+            test.entry ();
+        }
+    }
+
+    void unthrottledEventsAreSent ()
+    {
+        auto throttle = createThrottle ();
+
+        throttle->send (Event ("meter"));
+        throttle->send (Event ("meter"));
+
+        expectEquals (int (_sent.size ()), 2);
+    }
+
+    void keepLatestCoalesces ()
+    {
+        auto throttle = createThrottle ();
+        throttle->setPolicy ("meter", EventPolicy::keepLatest (longInterval));
+
+        for (auto level = 0; level < 4; ++level)
+            throttle->send (Event ("meter").withParameter ("level", level));
+
+        expectEquals (int (_sent.size ()), 1);
+
+        throttle->setPolicy ("meter", EventPolicy::unlimited ());
+
+        expectEquals (int (_sent.size ()), 2);
+        expectEquals (int (_sent.back () ["level"]), 3);
+        expectEquals (int (_sent.back () ["coalesced"]), 2);
+    }
+
+    void batchCollectsEvents ()
+    {
+        auto throttle = createThrottle ();
+        throttle->setPolicy ("parameter", EventPolicy::batch (longInterval));
+
+        for (auto value = 0; value < 3; ++value)
+            throttle->send (Event ("parameter").withParameter ("value", value));
+
+        expect (_sent.empty ());
+
+        throttle->setPolicy ("parameter", EventPolicy::unlimited ());
+
+        expectEquals (int (_sent.size ()), 1);
+        expectEquals (int (_sent.front () ["count"]), 3);
+        expectEquals (int (_sent.front () ["events"] [2] ["value"]), 2);
+    }
+
+    void policiesApplyByName ()
+    {
+        auto throttle = createThrottle ();
+        throttle->setPolicy ("meter", EventPolicy::batch (longInterval));
+
+        throttle->send (Event ("meter"));
+        throttle->send (Event ("other"));
+
+        expectEquals (int (_sent.size ()), 1);
+    }
+
+    void stoppingSendsPendingEvents ()
+    {
+        auto throttle = createThrottle ();
+        throttle->setPolicy ("meter", EventPolicy::keepLatest (longInterval));
+        throttle->setPolicy ("parameter", EventPolicy::batch (longInterval));
+
+        throttle->send (Event ("meter").withParameter ("level", 1));
+        throttle->send (Event ("meter").withParameter ("level", 2));
+        throttle->send (Event ("parameter"));
+
+        expectEquals (int (_sent.size ()), 1);
+
+        throttle->stop ();
+
+        expectEquals (int (_sent.size ()), 3);
+
+        throttle->send (Event ("meter"));
+        expectEquals (int (_sent.size ()), 4);
+    }
+
+    void destructionSendsPendingEvents ()
+    {
+        auto throttle = createThrottle ();
+        throttle->setPolicy ("parameter", EventPolicy::batch (longInterval));
+
+        throttle->send (Event ("parameter"));
+        expect (_sent.empty ());
+
+        throttle.reset ();
+
+        expectEquals (int (_sent.size ()), 1);
+        expectEquals (int (_sent.front () ["count"]), 1);
+    }
+
+    void libraryEventsAreReserved ()
+    {
+        auto throttle = createThrottle ();
+
+        const auto setPolicy = [&] (const juce::String & name)
+        {
+            auto args = std::make_unique<juce::DynamicObject> ();
+            args->setProperty ("name", name);
+            args->setProperty ("policy", "batch");
+            args->setProperty ("interval-ms", 100);
+
+            return throttle->process (Command::create ("set-event-policy", args.release ()));
+        };
+
+        const auto rejected = setPolicy ("app-metrics");
+        expect (rejected.has_value () && rejected->getResult ().failed ());
+
+        const auto accepted = setPolicy ("meter");
+        expect (accepted.has_value () && accepted->getResult ().wasOk ());
+
+        throttle->send (Event ("app-metrics"));
+        throttle->send (Event ("app-metrics"));
+
+        expectEquals (int (_sent.size ()), 2);
+    }
+
+    [[nodiscard]] std::unique_ptr<EventThrottle> createThrottle ()
+    {
+        _sent.clear ();
+        return std::make_unique<EventThrottle> ([this] (auto && event)
+                                                { _sent.push_back (event.getData ()); });
+    }
+
+private:
+    std::vector<juce::var> _sent;
+};
+
+[[maybe_unused]] static EventThrottleTests eventThrottleTests;
+
+}
@@ -0,0 +1,193 @@
+#include "../source/ConnectedTestCentre.h"
+#include "TestHelpers.h"
+
+#include <focusrite/e2e/ComponentSearch.h>
+
+namespace focusrite::e2e
+{
+struct CapturedWindow
+{
+    CapturedWindow ()
+    {
+        ComponentSearch::setTestId (component, "captured");
+        component.setBounds (0, 0, 20, 20);
+        window.addAndMakeVisible (component);
+        window.setVisible (true);
+    }
+
+    juce::TopLevelWindow window {"window", true};
+    juce::Component component;
+};
+
+class FrameCaptureTests final : public juce::UnitTest
+{
+public:
+    FrameCaptureTests () noexcept
+        : juce::UnitTest ("FrameCapture")
+    {
+    }
+
+    void runTest () override
+    {
+        struct Test
+        {
+            juce::String name;
+            std::function<void ()> entry;
+        };
+
+        auto tests = {
+            Test {"Sends every frame after stopping", [this] { sendsEveryFrame (); }},
+            Test {"Only one capture runs at a time", [this] { onlyOneCaptureRuns (); }},
+            Test {"Starts again straight after stopping", [this] { startsAgain (); }},
+        };
+
+        for (auto && test : tests)
+        {
+            beginTest (test.name);
+            test.entry ();
+        }
+    }
+
+    // The response to stop-capture comes first; the frames still in the buffer follow it
+    void sendsEveryFrame ()
+    {
+        static constexpr auto captureMs = 300;
+
+        if (! connect ())
+            return;
+
+        expect (bool (roundTrip ("start-capture", R"({"component-id":"captured","fps":60})")
+                          ["success"]));
+        juce::Thread::sleep (captureMs);
+
+        const auto stop = roundTrip ("stop-capture");
+        expect (bool (stop ["success"]));
+
+        const auto numCaptured = int (stop ["data"]["captured"]);
+        expectGreaterThan (numCaptured, 0);
+
+        auto numFrames = 0;
+        while (numFrames < numCaptured)
+        {
+            const auto frame = readEvent ("capture-frame");
+            if (frame.isVoid ())
+                break;
+
+            expectEquals (int (frame ["index"]), numFrames++);
+            expect (frame ["image"].toString ().isNotEmpty ());
+        }
+
+        expectEquals (numFrames, numCaptured);
+
+        disconnect ();
+    }
+
+    void onlyOneCaptureRuns ()
+    {
+        if (! connect ())
+            return;
+
+        expect (! bool (roundTrip ("stop-capture") ["success"]));
+        expect (bool (roundTrip ("start-capture", R"({"component-id":"captured"})") ["success"]));
+        expect (! bool (roundTrip ("start-capture", R"({"component-id":"captured"})") ["success"]));
+        expect (bool (roundTrip ("stop-capture") ["success"]));
+
+        disconnect ();
+    }
+
+    void startsAgain ()
+    {
+        if (! connect ())
+            return;
+
+        const auto first = roundTrip ("start-capture", R"({"component-id":"captured"})");
+        expect (bool (roundTrip ("stop-capture") ["success"]));
+
+        const auto second = roundTrip ("start-capture", R"({"component-id":"captured"})");
+        expect (bool (second ["success"]));
+        expectEquals (int (second ["data"]["capture-id"]), int (first ["data"]["capture-id"]) + 1);
+        expect (bool (roundTrip ("stop-capture") ["success"]));
+
+        disconnect ();
+    }
+
+private:
+    [[nodiscard]] bool connect ()
+    {
+        juce::StreamingSocket listener;
+        expect (listener.createListener (0));
+
+        runOnMessageQueue (
+            [&]
+            {
+                _window = std::make_unique<CapturedWindow> ();
+                _testCentre = createConnectedTestCentre (listener.getBoundPort ());
+            });
+
+        if (listener.waitUntilReady (true, acceptTimeoutMs) == 1)
+            _harness.reset (listener.waitForNextConnection ());
+
+        expect (_harness != nullptr);
+
+        if (_harness == nullptr)
+        {
+            disconnect ();
+            return false;
+        }
+
+        expect (! readEvent ("handshake").isVoid ());
+        return true;
+    }
+
+    void disconnect ()
+    {
+        if (_harness != nullptr)
+            _harness->close ();
+
+        runOnMessageQueue (
+            [&]
+            {
+                _testCentre.reset ();
+                _window.reset ();
+            });
+
+        _harness.reset ();
+    }
+
+    // Skips any events on the way
+    [[nodiscard]] juce::var roundTrip (const juce::String & type, const juce::String & args = "{}")
+    {
+        const auto uuid = juce::Uuid ().toDashedString ();
+        const auto json =
+            R"({"type":")" + type + R"(","uuid":")" + uuid + R"(","args":)" + args + "}";
+
+        if (! writeFrame (*_harness, json))
+            return {};
+
+        for (auto message = readJsonFrame (*_harness, acceptTimeoutMs); ! message.isVoid ();
+             message = readJsonFrame (*_harness, acceptTimeoutMs))
+            if (message ["uuid"].toString () == uuid)
+                return message;
+
+        return {};
+    }
+
+    // Returns the event's data, skipping anything else on the way
+    [[nodiscard]] juce::var readEvent (const juce::String & name)
+    {
+        for (auto message = readJsonFrame (*_harness, acceptTimeoutMs); ! message.isVoid ();
+             message = readJsonFrame (*_harness, acceptTimeoutMs))
+            if (message ["type"] == "event" && message ["name"].toString () == name)
+                return message ["data"];
+
+        return {};
+    }
+
+    std::unique_ptr<CapturedWindow> _window;
+    std::unique_ptr<TestCentre> _testCentre;
+    std::unique_ptr<juce::StreamingSocket> _harness;
+};
+
+[[maybe_unused]] static FrameCaptureTests frameCaptureTests;
+
+}
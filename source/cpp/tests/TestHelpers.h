@@ -0,0 +1,61 @@
+#pragma once
+
+#include <future>
+#include <juce_events/juce_events.h>
+
+namespace focusrite::e2e
+{
+static constexpr uint32_t magicNumber = 0x30061990;
+static constexpr auto acceptTimeoutMs = 5000;
+
+// Runs the task on the message thread and blocks until it has returned, passing on its result
+template <typename Task>
+static auto runOnMessageQueue (Task task)
+{
+    std::packaged_task<decltype (task ()) ()> packagedTask (std::move (task));
+    auto result = packagedTask.get_future ();
+
+    juce::MessageManager::callAsync ([&] { packagedTask (); });
+
+    return result.get ();
+}
+
+// Frames the data as the JavaScript library does
+[[nodiscard]] static bool writeFrame (juce::StreamingSocket & socket, const juce::String & data)
+{
+    const auto size = static_cast<uint32_t> (data.getNumBytesAsUTF8 ());
+
+    juce::MemoryOutputStream frame;
+    frame.writeInt (static_cast<int> (magicNumber));
+    frame.writeInt (static_cast<int> (size));
+    frame.write (data.toRawUTF8 (), size);
+
+    return socket.write (frame.getData (), int (frame.getDataSize ())) ==
+           int (frame.getDataSize ());
+}
+
+// Returns an empty string if nothing arrives within the timeout; a negative timeout waits forever
+[[nodiscard]] static juce::String readFrame (juce::StreamingSocket & socket, int timeoutMs = -1)
+{
+    if (timeoutMs >= 0 && socket.waitUntilReady (true, timeoutMs) != 1)
+        return {};
+
+    uint32_t header [2] {};
+    if (socket.read (header, sizeof (header), true) != int (sizeof (header)))
+        return {};
+
+    const auto size = juce::ByteOrder::swapIfBigEndian (header [1]);
+
+    juce::MemoryBlock payload (size);
+    if (socket.read (payload.getData (), int (size), true) != int (size))
+        return {};
+
+    return payload.toString ();
+}
+
+[[nodiscard]] static juce::var readJsonFrame (juce::StreamingSocket & socket, int timeoutMs = -1)
+{
+    return juce::JSON::parse (readFrame (socket, timeoutMs));
+}
+
+}
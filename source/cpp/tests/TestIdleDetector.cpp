@@ -0,0 +1,128 @@
+#include "TestHelpers.h"
+
+#include <focusrite/e2e/TestCentre.h>
+#include <juce_gui_basics/juce_gui_basics.h>
+
+namespace focusrite::e2e
+{
+class BusyTimer final : public juce::Timer
+{
+public:
+    void timerCallback () override
+    {
+        static constexpr auto workMs = 5;
+        juce::Thread::sleep (workMs);
+    }
+};
+
+class IdleDetectorTests final : public juce::UnitTest
+{
+public:
+    IdleDetectorTests () noexcept
+        : juce::UnitTest ("IdleDetector")
+    {
+    }
+
+    void runTest () override
+    {
+        struct Test
+        {
+            juce::String name;
+            std::function<void ()> entry;
+        };
+
+        auto tests = {
+            Test {"Responds after the quiet period", [this] { respondsAfterQuietPeriod (); }},
+            Test {"Times out while timers keep firing", [this] { timesOutWhileBusy (); }},
+            Test {"Removes its repaint hooks when done", [this] { removesRepaintHooks (); }},
+        };
+
+        for (auto && test : tests)
+        {
+            beginTest (test.name);
+            test.entry ();
+        }
+    }
+
+    void respondsAfterQuietPeriod ()
+    {
+        const auto response = waitForIdle (R"({"quiet-ms": 50, "timeout-ms": 5000})", false);
+
+        expect (response.getResult ().wasOk ());
+        expectGreaterOrEqual (double (response.getParameter ("waited-ms")), 50.0);
+    }
+
+    void timesOutWhileBusy ()
+    {
+        const auto response = waitForIdle (R"({"quiet-ms": 200, "timeout-ms": 300})", true);
+
+        expect (response.getResult ().failed ());
+        expectEquals (response.getParameter ("last-activity").toString (),
+                      juce::String ("message"));
+        expectGreaterThan (int (response.getParameter ("busy-probes")), 0);
+    }
+
+    void removesRepaintHooks ()
+    {
+        static constexpr auto settleMs = 50;
+
+        std::unique_ptr<juce::TopLevelWindow> window;
+        std::unique_ptr<TestCentre> testCentre;
+
+        auto response = runOnMessageQueue (
+            [&]
+            {
+                window = std::make_unique<juce::TopLevelWindow> ("window", true);
+                window->setBounds (0, 0, 10, 10);
+                window->setVisible (true);
+                testCentre = TestCentre::create ();
+
+                auto submitted = testCentre->submit (
+                    Command::create ("wait-for-idle", juce::JSON::parse (R"({"quiet-ms": 20})")));
+                expect (window->getCachedComponentImage () != nullptr);
+                return submitted;
+            });
+
+        expect (response.get ().getResult ().wasOk ());
+        juce::Thread::sleep (settleMs);
+
+        runOnMessageQueue (
+            [&]
+            {
+                expect (window->getCachedComponentImage () == nullptr);
+                testCentre.reset ();
+                window.reset ();
+            });
+    }
+
+private:
+    [[nodiscard]] static Response waitForIdle (const juce::String & args, bool busy)
+    {
+        BusyTimer timer;
+        auto testCentre = runOnMessageQueue (
+            [&]
+            {
+                if (busy)
+                    timer.startTimer (10);
+
+                return TestCentre::create ();
+            });
+
+        auto response =
+            testCentre->submit (Command::create ("wait-for-idle", juce::JSON::parse (args)));
+        const auto result = response.get ();
+
+        runOnMessageQueue (
+            [&]
+            {
+                timer.stopTimer ();
+                testCentre.reset ();
+            });
+
+        return result;
+    }
+};
+
+[[maybe_unused]] static IdleDetectorTests idleDetectorTests;
+
+}
@@ -0,0 +1,96 @@
+#include "../source/LatencyHistogram.h"
+
+namespace focusrite::e2e
+{
+class LatencyHistogramTests final : public juce::UnitTest
+{
+public:
+    LatencyHistogramTests () noexcept
+        : juce::UnitTest ("LatencyHistogram")
+    {
+    }
+
+    void runTest () override
+    {
+        struct Test
+        {
+            juce::String name;
+            std::function<void ()> entry;
+        };
+
+        auto tests = {
+            Test {"Small values are exact", [this] { smallValuesAreExact (); }},
+            Test {"Bucket bounds contain their values", [this] { bucketsContainValues (); }},
+            Test {"Percentiles are within precision", [this] { percentilesWithinPrecision (); }},
+            Test {"Count, mean and max", [this] { countMeanAndMax (); }},
+            Test {"Reset clears all values", [this] { resetClearsValues (); }},
+        };
+
+        for (auto && test : tests)
+        {
+            beginTest (test.name);
+            test.entry ();
+        }
+    }
+
+    void smallValuesAreExact ()
+    {
+        for (uint64_t value = 0; value < 32; ++value)
+            expectEquals (
+                juce::int64 (LatencyHistogram::getBucketUpperBound (
+                    LatencyHistogram::getBucketIndex (value))),
+                juce::int64 (value));
+    }
+
+    void bucketsContainValues ()
+    {
+        for (uint64_t value = 1; value < (uint64_t (1) << 36); value = value * 3 / 2 + 1)
+        {
+            const auto index = LatencyHistogram::getBucketIndex (value);
+            const auto upperBound = LatencyHistogram::getBucketUpperBound (index);
+
+            expect (index < LatencyHistogram::numBuckets);
+            expect (value <= upperBound);
+            expect (double (upperBound - value) <= double (value) / 16.0);
+        }
+    }
+
+    void percentilesWithinPrecision ()
+    {
+        LatencyHistogram histogram;
+
+        for (uint64_t value = 1; value <= 10000; ++value)
+            histogram.record (value);
+
+        expectWithinAbsoluteError (double (histogram.getPercentile (50.0)), 5000.0, 5000.0 / 16.0);
+        expectWithinAbsoluteError (double (histogram.getPercentile (99.0)), 9900.0, 9900.0 / 16.0);
+        expectEquals (juce::int64 (histogram.getPercentile (100.0)), juce::int64 (10000));
+    }
+
+    void countMeanAndMax ()
+    {
+        LatencyHistogram histogram;
+        histogram.record (10);
+        histogram.record (20);
+        histogram.record (90);
+
+        expectEquals (juce::int64 (histogram.getCount ()), juce::int64 (3));
+        expectEquals (histogram.getMean (), 40.0);
+        expectEquals (juce::int64 (histogram.getMax ()), juce::int64 (90));
+    }
+
+    void resetClearsValues ()
+    {
+        LatencyHistogram histogram;
+        histogram.record (1000);
+        histogram.reset ();
+
+        expectEquals (juce::int64 (histogram.getCount ()), juce::int64 (0));
+        expectEquals (juce::int64 (histogram.getMax ()), juce::int64 (0));
+        expectEquals (juce::int64 (histogram.getPercentile (50.0)), juce::int64 (0));
+    }
+};
+
+[[maybe_unused]] static LatencyHistogramTests latencyHistogramTests;
+
+}
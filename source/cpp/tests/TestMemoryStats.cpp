@@ -0,0 +1,134 @@
+#include "../source/AllocationTracker.h"
+#include "../source/MemoryStats.h"
+
+#include <array>
+
+namespace focusrite::e2e
+{
+class MemoryStatsTests final : public juce::UnitTest
+{
+public:
+    MemoryStatsTests () noexcept
+        : juce::UnitTest ("MemoryStats")
+    {
+    }
+
+    void runTest () override
+    {
+        struct Test
+        {
+            juce::String name;
+            std::function<void ()> entry;
+        };
+
+        auto tests = {
+            Test {"Parses status sizes", [this] { parsesStatusSizes (); }},
+            Test {"Parses the heap mapping", [this] { parsesHeapMapping (); }},
+            Test {"Counts allocations by owner", [this] { countsAllocationsByOwner (); }},
+            Test {"Records allocations per command", [this] { recordsAllocationsPerCommand (); }},
+        };
+
+        for (auto && test : tests)
+        {
+            beginTest (test.name);
+            test.entry ();
+        }
+    }
+
+    void parsesStatusSizes ()
+    {
+        const auto sizes = MemoryStats::parseStatus ("Name:\tapp\n"
+                                                     "VmHWM:\t   20480 kB\n"
+                                                     "VmRSS:\t   10240 kB\n"
+                                                     "Threads:\t4\n");
+
+        expectEquals (int (sizes.size ()), 2);
+        expectEquals (sizes.at ("VmRSS"), juce::int64 (10240));
+        expectEquals (sizes.at ("VmHWM"), juce::int64 (20480));
+    }
+
+    void parsesHeapMapping ()
+    {
+        const auto sizes = MemoryStats::parseHeap (
+            "55d0c3a00000-55d0c3a2e000 r--p 00000000 08:01 1234    /usr/bin/app\n"
+            "Size:                184 kB\n"
+            "Rss:                 180 kB\n"
+            "55d0c3a2e000-55d0c3a4f000 rw-p 00000000 00:00 0       [heap]\n"
+            "Size:                132 kB\n"
+            "Rss:                  96 kB\n"
+            "VmFlags: rd wr mr mw me ac sd\n"
+            "7f1e2c000000-7f1e2c021000 rw-p 00000000 00:00 0\n"
+            "Size:                132 kB\n");
+
+        expectEquals (sizes.at ("Size"), juce::int64 (132));
+        expectEquals (sizes.at ("Rss"), juce::int64 (96));
+    }
+
+    void countsAllocationsByOwner ()
+    {
+        using Owner = AllocationTracker::Owner;
+
+        const auto appBefore = AllocationTracker::getThreadCounts (Owner::app);
+        const auto libraryBefore = AllocationTracker::getThreadCounts (Owner::library);
+
+        {
+            const AllocationTracker::ScopedOwner owner (Owner::library);
+            doNotOptimise (std::make_unique<std::array<char, 100>> ());
+        }
+
+        const auto app = AllocationTracker::getThreadCounts (Owner::app);
+        const auto library = AllocationTracker::getThreadCounts (Owner::library);
+
+        expectEquals (app.allocations, appBefore.allocations);
+
+        if (AllocationTracker::isAvailable ())
+        {
+            expectEquals (library.allocations, libraryBefore.allocations + 1);
+            expectGreaterOrEqual (library.bytes, libraryBefore.bytes + 100);
+        }
+        else
+        {
+            expectEquals (library.allocations, uint64_t (0));
+        }
+    }
+
+    void recordsAllocationsPerCommand ()
+    {
+        AllocationTracker tracker;
+        const auto start = tracker.process (Command::create ("start-allocation-tracking"));
+
+        if (! AllocationTracker::isAvailable ())
+        {
+            expect (start->getResult ().failed ());
+            return;
+        }
+
+        expect (start->getResult ().wasOk ());
+
+        {
+            const AllocationTracker::ScopedOwner owner (AllocationTracker::Owner::library);
+            const AllocationTracker::ScopedCommand allocations (tracker, "test-command");
+            doNotOptimise (std::make_unique<int> ());
+        }
+
+        const auto stop = tracker.process (Command::create ("stop-allocation-tracking"));
+        const auto command = stop->getParameter ("commands")["test-command"];
+
+        expectEquals (int (command ["count"]), 1);
+        expectEquals (int (command ["library"]["allocations"]), 1);
+        expectEquals (int (command ["app"]["allocations"]), 0);
+    }
+
+private:
+    // Keeps the compiler from eliding the allocation
+    template <typename T>
+    static void doNotOptimise (const std::unique_ptr<T> & pointer)
+    {
+        static const void * volatile sink = nullptr;
+        sink = pointer.get ();
+    }
+};
+
+[[maybe_unused]] static MemoryStatsTests memoryStatsTests;
+
+}
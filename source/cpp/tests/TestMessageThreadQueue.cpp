@@ -0,0 +1,118 @@
+#include "../source/MessageThreadQueue.h"
+#include "TestHelpers.h"
+
+namespace focusrite::e2e
+{
+static constexpr auto capacity = 4;
+static constexpr auto deliveryTimeoutMs = 5000;
+
+class MessageThreadQueueTests final : public juce::UnitTest
+{
+public:
+    MessageThreadQueueTests () noexcept
+        : juce::UnitTest ("MessageThreadQueue")
+    {
+    }
+
+    void runTest () override
+    {
+        struct Test
+        {
+            juce::String name;
+            std::function<void ()> entry;
+        };
+
+        auto tests = {
+            Test {"Delivers items in order", [this] { deliversInOrder (); }},
+            Test {"Keeps the order when full", [this] { keepsOrderWhenFull (); }},
+            Test {"Keeps the order while overflowing", [this] { keepsOrderWhileOverflowing (); }},
+        };
+
+        for (auto && test : tests)
+        {
+            beginTest (test.name);
+            test.entry ();
+        }
+    }
+
+    void deliversInOrder ()
+    {
+        MessageThreadQueue<int> queue (capacity, deliver ());
+
+        for (auto item = 0; item < capacity; ++item)
+            queue.post (item);
+
+        expectDeliveredInOrder (capacity);
+    }
+
+    // The message thread can't deliver anything until the posting is done, so most items overflow
+    void keepsOrderWhenFull ()
+    {
+        static constexpr auto numItems = capacity * 4;
+
+        MessageThreadQueue<int> queue (capacity, deliver ());
+
+        runOnMessageQueue (
+            [&]
+            {
+                for (auto item = 0; item < numItems; ++item)
+                    queue.post (item);
+            });
+
+        expectDeliveredInOrder (numItems);
+    }
+
+    // Space frees up in the fifo while the overflow is still being delivered
+    void keepsOrderWhileOverflowing ()
+    {
+        static constexpr auto numItems = capacity * 64;
+
+        MessageThreadQueue<int> queue (capacity, deliver ());
+
+        for (auto item = 0; item < numItems; ++item)
+        {
+            queue.post (item);
+
+            if (item % capacity == 0)
+                juce::Thread::yield ();
+        }
+
+        expectDeliveredInOrder (numItems);
+    }
+
+private:
+    [[nodiscard]] MessageThreadQueue<int>::Callback deliver ()
+    {
+        _delivered.clear ();
+        _numDelivered = 0;
+
+        return [this] (auto && item)
+        {
+            _delivered.push_back (item);
+            ++_numDelivered;
+        };
+    }
+
+    void expectDeliveredInOrder (int numItems)
+    {
+        const auto timeoutMs = juce::Time::getMillisecondCounter () + deliveryTimeoutMs;
+
+        while (_numDelivered < numItems && juce::Time::getMillisecondCounter () < timeoutMs)
+            juce::Thread::sleep (1);
+
+        // Synchronises with the message thread before reading what it delivered
+        runOnMessageQueue ([] {});
+
+        expectEquals (int (_delivered.size ()), numItems);
+
+        for (auto index = 0; index < int (_delivered.size ()); ++index)
+            expectEquals (_delivered [size_t (index)], index);
+    }
+
+    std::vector<int> _delivered;
+    std::atomic<int> _numDelivered {0};
+};
+
+[[maybe_unused]] static MessageThreadQueueTests messageThreadQueueTests;
+
+}
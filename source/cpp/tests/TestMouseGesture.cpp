@@ -0,0 +1,116 @@
+#include "../source/MouseGesture.h"
+
+namespace focusrite::e2e
+{
+class MouseGestureTests final : public juce::UnitTest
+{
+public:
+    MouseGestureTests () noexcept
+        : juce::UnitTest ("MouseGesture")
+    {
+    }
+
+    void runTest () override
+    {
+        struct Test
+        {
+            juce::String name;
+            std::function<void ()> entry;
+        };
+
+        auto tests = {
+            Test {"Interpolates between points", [this] { interpolatesBetweenPoints (); }},
+            Test {"Buttons are held until the next point", [this] { buttonsAreHeld (); }},
+            Test {"Wheel deltas are not interpolated", [this] { wheelIsNotInterpolated (); }},
+            Test {"Rejects points out of time order", [this] { rejectsPointsOutOfOrder (); }},
+            Test {"Rejects a gesture without points", [this] { rejectsMissingPoints (); }},
+        };
+
+        for (auto && test : tests)
+        {
+            beginTest (test.name);
+            test.entry ();
+        }
+    }
+
+    void interpolatesBetweenPoints ()
+    {
+        const auto samples = createSamples (R"({
+            "step-ms": 10,
+            "points": [{"x": 0, "y": 0, "time-ms": 0}, {"x": 100, "y": 50, "time-ms": 100}]
+        })");
+
+        expectEquals (int (samples.size ()), 11);
+        expectEquals (samples [5].timeMs, 50.0);
+        expect (samples [5].position == juce::Point<float> (50.0f, 25.0f));
+        expect (samples.back ().position == juce::Point<float> (100.0f, 50.0f));
+    }
+
+    void buttonsAreHeld ()
+    {
+        const auto samples = createSamples (R"({
+            "points": [
+                {"x": 0, "y": 0, "time-ms": 0, "buttons": "left", "modifiers": "shift"},
+                {"x": 10, "y": 0, "time-ms": 30}
+            ]
+        })");
+
+        expectEquals (int (samples.size ()), 4);
+
+        for (size_t index = 0; index < 3; ++index)
+        {
+            expect (samples [index].modifiers.isLeftButtonDown ());
+            expect (samples [index].modifiers.isShiftDown ());
+        }
+
+        expect (! samples.back ().modifiers.isAnyMouseButtonDown ());
+        expect (! samples.back ().modifiers.isShiftDown ());
+    }
+
+    void wheelIsNotInterpolated ()
+    {
+        const auto samples = createSamples (R"({
+            "points": [{"x": 0, "y": 0, "time-ms": 0, "wheel-y": 0.5},
+                       {"x": 0, "y": 0, "time-ms": 20}]
+        })");
+
+        expectEquals (int (samples.size ()), 3);
+        expectEquals (samples [0].wheelDelta.y, 0.5f);
+        expect (samples [1].wheelDelta.isOrigin ());
+        expect (samples [2].wheelDelta.isOrigin ());
+    }
+
+    void rejectsPointsOutOfOrder ()
+    {
+        std::vector<MouseGesture::Sample> samples;
+        const auto result = MouseGesture::createSamples (
+            createCommand (R"({"points": [{"time-ms": 10}, {"time-ms": 5}]})"), samples);
+
+        expect (result.failed ());
+    }
+
+    void rejectsMissingPoints ()
+    {
+        std::vector<MouseGesture::Sample> samples;
+        expect (MouseGesture::createSamples (createCommand ("{}"), samples).failed ());
+        expect (MouseGesture::createSamples (createCommand (R"({"points": []})"), samples)
+                    .failed ());
+    }
+
+private:
+    [[nodiscard]] static Command createCommand (const juce::String & args)
+    {
+        return Command::create ("mouse-gesture", juce::JSON::parse (args));
+    }
+
+    [[nodiscard]] std::vector<MouseGesture::Sample> createSamples (const juce::String & args)
+    {
+        std::vector<MouseGesture::Sample> samples;
+        expect (MouseGesture::createSamples (createCommand (args), samples).wasOk ());
+        return samples;
+    }
+};
+
+[[maybe_unused]] static MouseGestureTests mouseGestureTests;
+
+}
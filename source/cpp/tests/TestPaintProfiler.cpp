@@ -0,0 +1,165 @@
+#include "../source/PaintProfiler.h"
+#include "TestHelpers.h"
+
+#include <focusrite/e2e/ComponentSearch.h>
+
+namespace focusrite::e2e
+{
+class SlowComponent final : public juce::Component
+{
+public:
+    SlowComponent (const juce::String & testId, int paintMs)
+        : _paintMs (paintMs)
+    {
+        if (testId.isNotEmpty ())
+            ComponentSearch::setTestId (*this, testId);
+
+        setBounds (0, 0, 10, 10);
+    }
+
+    void paint (juce::Graphics & graphics) override
+    {
+        juce::ignoreUnused (graphics);
+        juce::Thread::sleep (_paintMs);
+    }
+
+private:
+    const int _paintMs;
+};
+
+// panel
+// ├── meter
+// └── (unnamed)
+struct ProfiledTree
+{
+    ProfiledTree ()
+    {
+        root.setBounds (0, 0, 10, 10);
+        root.addAndMakeVisible (panel);
+        panel.addAndMakeVisible (meter);
+        panel.addAndMakeVisible (unnamed);
+    }
+
+    void paint ()
+    {
+        juce::Image image (juce::Image::ARGB, 10, 10, true);
+        juce::Graphics graphics (image);
+        root.paintEntireComponent (graphics, false);
+    }
+
+    juce::Component root;
+    SlowComponent panel {"panel", 1};
+    SlowComponent meter {"meter", 20};
+    SlowComponent unnamed {{}, 1};
+};
+
+class PaintProfilerTests final : public juce::UnitTest
+{
+public:
+    PaintProfilerTests () noexcept
+        : juce::UnitTest ("PaintProfiler")
+    {
+    }
+
+    void runTest () override
+    {
+        struct Test
+        {
+            juce::String name;
+            std::function<void ()> entry;
+        };
+
+        auto tests = {
+            Test {"Counts paints by test id", [this] { countsPaintsByTestId (); }},
+            Test {"Excludes profiled children", [this] { excludesProfiledChildren (); }},
+            Test {"Limits the components reported", [this] { limitsComponents (); }},
+            Test {"Restores components when stopped", [this] { restoresComponents (); }},
+            Test {"Skips components with a cached image", [this] { skipsCachedComponents (); }},
+        };
+
+        for (auto && test : tests)
+        {
+            beginTest (test.name);
+            runOnMessageQueue (test.entry);
+        }
+    }
+
+    void countsPaintsByTestId ()
+    {
+        const auto components = profile (2, 10);
+
+        expectEquals (components.size (), 2);
+        expectEquals (components [0]["test-id"].toString (), juce::String ("meter"));
+        expectEquals (int (components [0]["paints"]), 2);
+        expectEquals (components [1]["test-id"].toString (), juce::String ("panel"));
+        expectEquals (int (components [1]["paints"]), 2);
+    }
+
+    void excludesProfiledChildren ()
+    {
+        const auto components = profile (1, 10);
+
+        expectLessThan (double (components [1]["total-ms"]), double (components [0]["total-ms"]));
+    }
+
+    void limitsComponents ()
+    {
+        ProfiledTree tree;
+        PaintProfiler profiler;
+
+        profiler.start ({&tree.root});
+        tree.paint ();
+        const auto response = profiler.stop (1);
+
+        expectEquals (response.getParameter ("components").size (), 1);
+        expectGreaterThan (double (response.getParameter ("total-ms")),
+                           double (response.getParameter ("components")[0]["total-ms"]));
+    }
+
+    void restoresComponents ()
+    {
+        ProfiledTree tree;
+        PaintProfiler profiler;
+
+        profiler.start ({&tree.root});
+        expect (tree.panel.getCachedComponentImage () != nullptr);
+        expect (tree.unnamed.getCachedComponentImage () == nullptr);
+
+        juce::ignoreUnused (profiler.stop (10));
+        expect (! profiler.isProfiling ());
+        expect (tree.panel.getCachedComponentImage () == nullptr);
+        expect (tree.meter.getCachedComponentImage () == nullptr);
+    }
+
+    void skipsCachedComponents ()
+    {
+        ProfiledTree tree;
+        tree.meter.setBufferedToImage (true);
+
+        PaintProfiler profiler;
+        profiler.start ({&tree.root});
+        tree.paint ();
+
+        const auto components = profiler.stop (10).getParameter ("components");
+        expectEquals (components.size (), 1);
+        expectEquals (components [0]["test-id"].toString (), juce::String ("panel"));
+    }
+
+private:
+    [[nodiscard]] static juce::var profile (int numPaints, int maxComponents)
+    {
+        ProfiledTree tree;
+        PaintProfiler profiler;
+
+        profiler.start ({&tree.root});
+
+        for (int paint = 0; paint < numPaints; ++paint)
+            tree.paint ();
+
+        return profiler.stop (maxComponents).getParameter ("components");
+    }
+};
+
+[[maybe_unused]] static PaintProfilerTests paintProfilerTests;
+
+}
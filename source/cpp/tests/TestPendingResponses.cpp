@@ -0,0 +1,96 @@
+#include "../source/PendingResponses.h"
+
+namespace focusrite::e2e
+{
+class PendingResponsesTests final : public juce::UnitTest
+{
+public:
+    PendingResponsesTests () noexcept
+        : juce::UnitTest ("PendingResponses")
+    {
+    }
+
+    void runTest () override
+    {
+        struct Test
+        {
+            juce::String name;
+            std::function<void ()> entry;
+        };
+
+        auto tests = {
+            Test {"Response carries the command UUID", [this] { responseCarriesUuid (); }},
+            Test {"Only the first response is sent", [this] { onlyFirstResponseIsSent (); }},
+            Test {"Expires after the timeout", [this] { expiresAfterTimeout (); }},
+            Test {"Timeout failure names the command", [this] { timeoutNamesCommand (); }},
+        };
+
+        for (auto && test : tests)
+        {
+            beginTest (test.name);
+            test.entry ();
+        }
+    }
+
+    void responseCarriesUuid ()
+    {
+        auto pending = createPendingResponse (juce::RelativeTime::seconds (1.0));
+
+        pending->respond (Response::ok ());
+
+        expectEquals (int (_sent.size ()), 1);
+        expectEquals (juce::JSON::parse (_sent.front ()) ["uuid"].toString (),
+                      _command.getUuid ().toDashedString ());
+    }
+
+    void onlyFirstResponseIsSent ()
+    {
+        auto pending = createPendingResponse (juce::RelativeTime::seconds (1.0));
+
+        expect (! pending->hasResponded ());
+
+        pending->respond (Response::ok ());
+        pending->respond (Response::fail ("Too late"));
+
+        expect (pending->hasResponded ());
+        expectEquals (int (_sent.size ()), 1);
+        expect (bool (juce::JSON::parse (_sent.front ()) ["success"]));
+    }
+
+    void expiresAfterTimeout ()
+    {
+        auto pending = createPendingResponse (juce::RelativeTime::milliseconds (100));
+        const auto now = juce::Time::getMillisecondCounterHiRes ();
+
+        expect (! pending->hasExpired (now));
+        expect (pending->hasExpired (now + 200.0));
+    }
+
+    void timeoutNamesCommand ()
+    {
+        auto pending = createPendingResponse (juce::RelativeTime::milliseconds (100));
+
+        pending->failWithTimeout ();
+
+        expectEquals (int (_sent.size ()), 1);
+        expectEquals (juce::JSON::parse (_sent.front ()) ["error"].toString (),
+                      juce::String ("Timed out after 100 ms waiting for load-preset"));
+    }
+
+    [[nodiscard]] std::shared_ptr<PendingResponse>
+    createPendingResponse (juce::RelativeTime timeout)
+    {
+        _sent.clear ();
+
+        return std::make_shared<PendingResponse> (
+            _command, timeout, [this] (auto && response) { _sent.push_back (response.toJson ()); });
+    }
+
+private:
+    const Command _command {"load-preset", juce::Uuid (), {}};
+    std::vector<juce::String> _sent;
+};
+
+[[maybe_unused]] static PendingResponsesTests pendingResponsesTests;
+
+}
@@ -0,0 +1,134 @@
+#include "../source/RealtimeEventQueue.h"
+
+#include <thread>
+
+namespace focusrite::e2e
+{
+class RealtimeEventQueueTests final : public juce::UnitTest
+{
+public:
+    RealtimeEventQueueTests () noexcept
+        : juce::UnitTest ("RealtimeEventQueue")
+    {
+    }
+
+    void runTest () override
+    {
+        struct Test
+        {
+            juce::String name;
+            std::function<void ()> entry;
+        };
+
+        auto tests = {
+            Test {"Events are popped in order", [this] { eventsArePoppedInOrder (); }},
+            Test {"Push fails when full", [this] { pushFailsWhenFull (); }},
+            Test {"Long names are truncated", [this] { longNamesAreTruncated (); }},
+            Test {"Extra parameters are ignored", [this] { extraParametersAreIgnored (); }},
+            Test {"Concurrent producers lose nothing", [this] { concurrentProducers (); }},
+        };
+
+        for (auto && test : tests)
+        {
+            beginTest (test.name);
+            test.entry ();
+        }
+    }
+
+    void eventsArePoppedInOrder ()
+    {
+        RealtimeEventQueue queue (8);
+
+        for (auto index = 0; index < 5; ++index)
+            expect (queue.push (RealtimeEvent ("event").withParameter ("index", index)));
+
+        RealtimeEvent event;
+
+        for (auto index = 0; index < 5; ++index)
+        {
+            expect (queue.pop (event));
+            expectEquals (juce::String (event.getName ()), juce::String ("event"));
+            expectEquals (event.getParameterValue (0), double (index));
+        }
+
+        expect (! queue.pop (event));
+    }
+
+    void pushFailsWhenFull ()
+    {
+        RealtimeEventQueue queue (4);
+
+        for (auto index = 0; index < 4; ++index)
+            expect (queue.push (RealtimeEvent ("event")));
+
+        expect (! queue.push (RealtimeEvent ("event")));
+
+        RealtimeEvent event;
+        expect (queue.pop (event));
+        expect (queue.push (RealtimeEvent ("event")));
+    }
+
+    void longNamesAreTruncated ()
+    {
+        const juce::String name ("an-event-name-that-is-longer-than-the-fixed-size-buffer");
+        const RealtimeEvent event (name.toRawUTF8 ());
+
+        expectEquals (juce::String (event.getName ()),
+                      name.substring (0, int (RealtimeEvent::maxNameLength)));
+    }
+
+    void extraParametersAreIgnored ()
+    {
+        auto event = RealtimeEvent ("event");
+
+        for (size_t index = 0; index < RealtimeEvent::maxParameters + 2; ++index)
+            event = event.withParameter ("value", double (index));
+
+        expectEquals (int (event.getNumParameters ()), int (RealtimeEvent::maxParameters));
+    }
+
+    void concurrentProducers ()
+    {
+        static constexpr auto numProducers = 4;
+        static constexpr auto eventsPerProducer = 10000;
+
+        RealtimeEventQueue queue (1024);
+        std::atomic<int> numPushed {0};
+        std::atomic<int> numFinished {0};
+        std::vector<std::thread> producers;
+
+        for (auto producer = 0; producer < numProducers; ++producer)
+            producers.emplace_back (
+                [&]
+                {
+                    for (auto index = 0; index < eventsPerProducer; ++index)
+                        if (queue.push (RealtimeEvent ("event")))
+                            ++numPushed;
+
+                    ++numFinished;
+                });
+
+        auto numPopped = 0;
+        RealtimeEvent event;
+
+        const auto drain = [&]
+        {
+            while (queue.pop (event))
+                ++numPopped;
+        };
+
+        while (numFinished < numProducers)
+            drain ();
+
+        for (auto & producer : producers)
+            producer.join ();
+
+        drain ();
+
+        expectEquals (numPopped, numPushed.load ());
+    }
+};
+
+[[maybe_unused]] static RealtimeEventQueueTests realtimeEventQueueTests;
+
+}
@@ -0,0 +1,83 @@
+#include "../source/ScratchArena.h"
+
+namespace focusrite::e2e
+{
+class ScratchArenaTests final : public juce::UnitTest
+{
+public:
+    ScratchArenaTests () noexcept
+        : juce::UnitTest ("ScratchArena")
+    {
+    }
+
+    void runTest () override
+    {
+        struct Test
+        {
+            juce::String name;
+            std::function<void ()> entry;
+        };
+
+        auto tests = {
+            Test {"Grows to fit the largest command", [this] { growsToFitLargestCommand (); }},
+            Test {"Stays within its ceiling", [this] { staysWithinCeiling (); }},
+        };
+
+        for (auto && test : tests)
+        {
+            beginTest (test.name);
+            test.entry ();
+        }
+    }
+
+    void growsToFitLargestCommand ()
+    {
+        const auto numBytes = ScratchArena::getCapacity () + 1000;
+
+        {
+            const ScratchArena::Scope scope;
+            std::memset (ScratchArena::allocate (numBytes), 0, numBytes);
+
+            {
+                const ScratchArena::Scope inner;
+                std::memset (ScratchArena::allocate (numBytes), 0, numBytes);
+            }
+
+            // Only the outermost scope resizes the block
+            expect (ScratchArena::getCapacity () < numBytes);
+        }
+
+        const auto capacity = ScratchArena::getCapacity ();
+        expect (capacity >= numBytes * 2);
+
+        {
+            const ScratchArena::Scope scope;
+            std::memset (ScratchArena::allocate (numBytes), 0, numBytes);
+        }
+
+        expectEquals (ScratchArena::getCapacity (), capacity);
+    }
+
+    void staysWithinCeiling ()
+    {
+        const auto numBytes = ScratchArena::maxCapacity * 4;
+
+        {
+            const ScratchArena::Scope scope;
+            std::memset (ScratchArena::allocate (numBytes), 0, numBytes);
+        }
+
+        expectEquals (ScratchArena::getCapacity (), ScratchArena::maxCapacity);
+
+        {
+            const ScratchArena::Scope scope;
+            std::memset (ScratchArena::allocate (numBytes), 0, numBytes);
+        }
+
+        expectEquals (ScratchArena::getCapacity (), ScratchArena::maxCapacity);
+    }
+};
+
+[[maybe_unused]] static ScratchArenaTests scratchArenaTests;
+
+}
@@ -0,0 +1,149 @@
+#include "../source/Screenshot.h"
+
+namespace focusrite::e2e
+{
+static constexpr auto tileSize = 32;
+
+[[nodiscard]] static juce::Image createImage (int width, int height)
+{
+    juce::Image image (juce::Image::ARGB, width, height, true);
+    juce::Graphics (image).fillAll (juce::Colours::white);
+    return image;
+}
+
+class ScreenshotTests final : public juce::UnitTest
+{
+public:
+    ScreenshotTests () noexcept
+        : juce::UnitTest ("Screenshot")
+    {
+    }
+
+    void runTest () override
+    {
+        struct Test
+        {
+            juce::String name;
+            std::function<void ()> entry;
+        };
+
+        auto tests = {
+            Test {"Identical images have no changed regions", [this] { identicalImages (); }},
+            Test {"Changed pixel marks its tile", [this] { changedPixelMarksTile (); }},
+            Test {"Adjacent changed tiles are merged", [this] { adjacentTilesAreMerged (); }},
+            Test {"Edge tiles are clipped to the image", [this] { edgeTilesAreClipped (); }},
+            Test {"Downscaling averages source pixels", [this] { downscalingAverages (); }},
+            Test {"Downscaling keeps solid areas", [this] { downscalingKeepsSolidAreas (); }},
+            Test {"History forgets the least recently used capture",
+                  [this] { historyForgetsLeastRecentlyUsed (); }},
+        };
+
+        for (auto && test : tests)
+        {
+            beginTest (test.name);
+            test.entry ();
+        }
+    }
+
+    void identicalImages ()
+    {
+        const auto previous = createImage (100, 80);
+        const auto current = previous.createCopy ();
+
+        expect (findChangedRegions (previous, current, tileSize).empty ());
+    }
+
+    void changedPixelMarksTile ()
+    {
+        const auto previous = createImage (100, 80);
+        auto current = previous.createCopy ();
+        current.setPixelAt (40, 5, juce::Colours::red);
+
+        const auto regions = findChangedRegions (previous, current, tileSize);
+
+        expectEquals (int (regions.size ()), 1);
+        expect (regions.front () == juce::Rectangle<int> (32, 0, 32, 32));
+    }
+
+    void adjacentTilesAreMerged ()
+    {
+        const auto previous = createImage (100, 80);
+        auto current = previous.createCopy ();
+        juce::Graphics (current).fillRect (10, 10, 40, 40);
+
+        const auto regions = findChangedRegions (previous, current, tileSize);
+
+        expectEquals (int (regions.size ()), 1);
+        expect (regions.front () == juce::Rectangle<int> (0, 0, 64, 64));
+    }
+
+    void edgeTilesAreClipped ()
+    {
+        const auto previous = createImage (70, 50);
+        auto current = previous.createCopy ();
+        current.setPixelAt (69, 49, juce::Colours::red);
+
+        const auto regions = findChangedRegions (previous, current, tileSize);
+
+        expectEquals (int (regions.size ()), 1);
+        expect (regions.front () == juce::Rectangle<int> (64, 32, 6, 18));
+    }
+
+    void downscalingAverages ()
+    {
+        juce::Image image (juce::Image::ARGB, 2, 2, true);
+        image.setPixelAt (0, 0, juce::Colours::white);
+        image.setPixelAt (1, 0, juce::Colours::black);
+        image.setPixelAt (0, 1, juce::Colours::black);
+        image.setPixelAt (1, 1, juce::Colours::white);
+
+        const auto scaled = downscaleImage (image, 1, 1);
+
+        expectEquals (scaled.getWidth (), 1);
+        expectEquals (scaled.getHeight (), 1);
+        expectEquals (int (scaled.getPixelAt (0, 0).getRed ()), 128);
+        expectEquals (int (scaled.getPixelAt (0, 0).getAlpha ()), 255);
+    }
+
+    void downscalingKeepsSolidAreas ()
+    {
+        auto image = createImage (64, 48);
+
+        {
+            juce::Graphics graphics (image);
+            graphics.setColour (juce::Colours::red);
+            graphics.fillRect (0, 0, 32, 48);
+        }
+
+        const auto scaled = downscaleImage (image, 16, 12);
+
+        expectEquals (scaled.getWidth (), 16);
+        expectEquals (scaled.getHeight (), 12);
+        expect (scaled.getPixelAt (2, 6) == juce::Colours::red);
+        expect (scaled.getPixelAt (13, 6) == juce::Colours::white);
+    }
+
+    void historyForgetsLeastRecentlyUsed ()
+    {
+        ScreenshotHistory history;
+        const auto image = createImage (8, 8);
+
+        const auto isKeyframe = [&] (const juce::String & key)
+        { return bool (history.createDelta (key, image, false).getParameter ("keyframe")); };
+
+        expect (isKeyframe ("oldest"));
+        expect (isKeyframe ("recent"));
+
+        for (size_t index = 2; index < ScreenshotHistory::maxCaptures; ++index)
+            expect (isKeyframe (juce::String (int (index))));
+
+        expect (! isKeyframe ("oldest"));
+        expect (isKeyframe ("newest"));
+        expect (isKeyframe ("recent"));
+        expect (! isKeyframe ("oldest"));
+    }
+};
+
+[[maybe_unused]] static ScreenshotTests screenshotTests;
+
+}
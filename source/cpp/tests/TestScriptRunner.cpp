@@ -0,0 +1,158 @@
+#include "../source/ScriptRunner.h"
+#include "TestHelpers.h"
+
+namespace focusrite::e2e
+{
+class CountingHandler final : public CommandHandler
+{
+public:
+    std::optional<Response> process (const Command & command) override
+    {
+        if (command.getType () == "count")
+            return Response::ok ().withParameter ("count", ++_count);
+
+        if (command.getType () == "fail")
+            return Response::fail ("Failed on purpose");
+
+        return std::nullopt;
+    }
+
+private:
+    int _count = 0;
+};
+
+class ScriptRunnerTests final : public juce::UnitTest
+{
+public:
+    ScriptRunnerTests () noexcept
+        : juce::UnitTest ("ScriptRunner")
+    {
+    }
+
+    void runTest () override
+    {
+        struct Test
+        {
+            juce::String name;
+            std::function<void ()> entry;
+        };
+
+        auto tests = {
+            Test {"Runs steps in order", [this] { runsStepsInOrder (); }},
+            Test {"Waits for expected values", [this] { waitsForExpectedValues (); }},
+            Test {"Stops at the first failure", [this] { stopsAtFirstFailure (); }},
+            Test {"Gives up waiting after the timeout", [this] { givesUpWaiting (); }},
+            Test {"Rejects invalid steps", [this] { rejectsInvalidSteps (); }},
+            Test {"Checks expected parameters", [this] { checksExpectedParameters (); }},
+        };
+
+        for (auto && test : tests)
+        {
+            beginTest (test.name);
+            test.entry ();
+        }
+    }
+
+    void runsStepsInOrder ()
+    {
+        const auto response = runScript (R"([
+            {"type": "count"},
+            {"type": "sleep", "args": {"ms": 20}},
+            {"type": "count", "expect": {"count": 2}}
+        ])");
+
+        expect (response.getResult ().wasOk ());
+
+        const auto steps = response.getParameter ("steps");
+        expectEquals (steps.size (), 3);
+        expectEquals (steps [1]["type"].toString (), juce::String ("sleep"));
+        expectGreaterOrEqual (double (steps [1]["duration-ms"]), 20.0);
+    }
+
+    void waitsForExpectedValues ()
+    {
+        const auto response = runScript (R"([
+            {"type": "count", "wait": true, "expect": {"count": 3}}
+        ])");
+
+        expect (response.getResult ().wasOk ());
+        expectEquals (int (response.getParameter ("steps")[0]["attempts"]), 3);
+    }
+
+    void stopsAtFirstFailure ()
+    {
+        const auto response = runScript (R"([
+            {"type": "count"},
+            {"type": "fail"},
+            {"type": "count"}
+        ])");
+
+        expect (response.getResult ().failed ());
+        expectEquals (response.getResult ().getErrorMessage (),
+                      juce::String ("Step 1 (fail): Failed on purpose"));
+        expectEquals (int (response.getParameter ("failed-step")), 1);
+        expectEquals (response.getParameter ("steps").size (), 2);
+    }
+
+    void givesUpWaiting ()
+    {
+        const auto response = runScript (R"([
+            {"type": "count", "wait": true, "timeout-ms": 50, "expect": {"count": -1}}
+        ])");
+
+        expect (response.getResult ().failed ());
+        expect (response.getResult ().getErrorMessage ().contains ("Expected count to be -1"));
+        expectGreaterThan (int (response.getParameter ("steps")[0]["attempts"]), 1);
+    }
+
+    void rejectsInvalidSteps ()
+    {
+        expect (ScriptRunner::validate ({}).failed ());
+        expect (ScriptRunner::validate (juce::JSON::parse (R"([{"args": {}}])")).failed ());
+        expect (ScriptRunner::validate (juce::JSON::parse (R"([{"type": "run-script"}])"))
+                    .failed ());
+        expect (ScriptRunner::validate (juce::JSON::parse (R"([{"type": "sleep", "wait": true}])"))
+                    .failed ());
+        expect (ScriptRunner::validate (juce::JSON::parse (R"([{"type": "count"}])")).wasOk ());
+    }
+
+    void checksExpectedParameters ()
+    {
+        const auto response =
+            Response::ok ().withParameter ("text", "Hello").withParameter ("showing", true);
+
+        expect (ScriptRunner::check (response, {}).wasOk ());
+        expect (
+            ScriptRunner::check (response, juce::JSON::parse (R"({"text": "Hello"})")).wasOk ());
+        expect (ScriptRunner::check (response, juce::JSON::parse (R"({"showing": false})"))
+                    .failed ());
+        expect (ScriptRunner::check (response, juce::JSON::parse (R"({"missing": 1})")).failed ());
+        expect (ScriptRunner::check (Response::fail ("Nope"), {}).failed ());
+    }
+
+private:
+    [[nodiscard]] static Response runScript (const juce::String & steps)
+    {
+        CountingHandler handler;
+        auto testCentre = runOnMessageQueue (
+            [&]
+            {
+                auto created = TestCentre::create ();
+                created->addCommandHandler (handler);
+                return created;
+            });
+
+        auto args = std::make_unique<juce::DynamicObject> ();
+        args->setProperty ("steps", juce::JSON::parse (steps));
+
+        auto response = testCentre->submit (Command::create ("run-script", args.release ()));
+        const auto result = response.get ();
+
+        runOnMessageQueue ([&] { testCentre.reset (); });
+        return result;
+    }
+};
+
+[[maybe_unused]] static ScriptRunnerTests scriptRunnerTests;
+
+}
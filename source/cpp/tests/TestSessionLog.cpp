@@ -0,0 +1,106 @@
+#include "../source/SessionLog.h"
+
+namespace focusrite::e2e
+{
+class SessionLogTests final : public juce::UnitTest
+{
+public:
+    SessionLogTests () noexcept
+        : juce::UnitTest ("SessionLog")
+    {
+    }
+
+    void runTest () override
+    {
+        struct Test
+        {
+            juce::String name;
+            std::function<void ()> entry;
+        };
+
+        auto tests = {
+            Test {"Reads back appended entries", [this] { readsBackAppendedEntries (); }},
+            Test {"Entry times increase", [this] { entryTimesIncrease (); }},
+            Test {"Ignores a truncated final entry", [this] { ignoresTruncatedEntry (); }},
+            Test {"Rejects files that aren't session logs", [this] { rejectsOtherFiles (); }},
+        };
+
+        for (auto && test : tests)
+        {
+            beginTest (test.name);
+            test.entry ();
+        }
+    }
+
+    void readsBackAppendedEntries ()
+    {
+        const juce::TemporaryFile file;
+        writeLog (file.getFile ());
+
+        std::vector<SessionLog::Entry> entries;
+        expect (SessionLog::read (file.getFile (), entries).wasOk ());
+
+        expectEquals (int (entries.size ()), 3);
+        expect (entries [0].kind == SessionLog::Kind::command);
+        expect (entries [1].kind == SessionLog::Kind::event);
+        expect (entries [2].kind == SessionLog::Kind::response);
+        expectEquals (entries [0].json, juce::String (commandJson));
+        expectEquals (entries [2].json, juce::String (responseJson));
+    }
+
+    void entryTimesIncrease ()
+    {
+        const juce::TemporaryFile file;
+        writeLog (file.getFile ());
+
+        std::vector<SessionLog::Entry> entries;
+        expect (SessionLog::read (file.getFile (), entries).wasOk ());
+
+        expect (entries [0].timeUs >= 0);
+        expect (entries [0].timeUs <= entries [1].timeUs);
+        expect (entries [1].timeUs <= entries [2].timeUs);
+    }
+
+    void ignoresTruncatedEntry ()
+    {
+        const juce::TemporaryFile file;
+        writeLog (file.getFile ());
+
+        juce::MemoryBlock data;
+        expect (file.getFile ().loadFileAsData (data));
+        data.setSize (data.getSize () - 3);
+        expect (file.getFile ().replaceWithData (data.getData (), data.getSize ()));
+
+        std::vector<SessionLog::Entry> entries;
+        expect (SessionLog::read (file.getFile (), entries).wasOk ());
+        expectEquals (int (entries.size ()), 2);
+    }
+
+    void rejectsOtherFiles ()
+    {
+        const juce::TemporaryFile file;
+        expect (file.getFile ().replaceWithText (commandJson));
+
+        std::vector<SessionLog::Entry> entries;
+        expect (SessionLog::read (file.getFile (), entries).failed ());
+        expect (SessionLog::read (file.getFile ().getSiblingFile ("missing"), entries).failed ());
+    }
+
+private:
+    static constexpr auto commandJson = R"({"type":"get-metrics","uuid":"1","args":{}})";
+    static constexpr auto responseJson = R"({"type":"response","uuid":"1","success":true})";
+
+    static void writeLog (const juce::File & file)
+    {
+        auto writer = SessionLogWriter::create (file);
+        jassert (writer != nullptr);
+
+        writer->append (SessionLog::Kind::command, commandJson);
+        writer->append (SessionLog::Kind::event, R"({"type":"event","name":"changed"})");
+        writer->append (SessionLog::Kind::response, responseJson);
+    }
+};
+
+[[maybe_unused]] static SessionLogTests sessionLogTests;
+
+}
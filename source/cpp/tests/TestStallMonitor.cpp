@@ -0,0 +1,119 @@
+#include "../source/StallMonitor.h"
+#include "TestHelpers.h"
+
+#include <focusrite/e2e/TestCentre.h>
+
+namespace focusrite::e2e
+{
+static constexpr auto blockMs = 200;
+
+class StallMonitorTests final : public juce::UnitTest
+{
+public:
+    StallMonitorTests () noexcept
+        : juce::UnitTest ("StallMonitor")
+    {
+    }
+
+    void runTest () override
+    {
+        struct Test
+        {
+            juce::String name;
+            std::function<void ()> entry;
+        };
+
+        auto tests = {
+            Test {"Reports a stall over the threshold", [this] { reportsStallOverThreshold (); }},
+            Test {"Ignores a delay under the threshold", [this] { ignoresDelayUnderThreshold (); }},
+            Test {"Reset clears the report", [this] { resetClearsReport (); }},
+        };
+
+        for (auto && test : tests)
+        {
+            beginTest (test.name);
+            test.entry ();
+        }
+    }
+
+    void reportsStallOverThreshold ()
+    {
+        const auto report = getReportAfterBlocking (50);
+
+        expectEquals (int (report.getParameter ("threshold-ms")), 50);
+        expectGreaterOrEqual (int (report.getParameter ("stall-count")), 1);
+        expectEquals (report.getParameter ("stalls").size (),
+                      int (report.getParameter ("stall-count")));
+        expectGreaterThan (double (report.getParameter ("max-stall-ms")), 50.0);
+        expectGreaterThan (int (report.getParameter ("heartbeats")), 0);
+    }
+
+    void ignoresDelayUnderThreshold ()
+    {
+        const auto report = getReportAfterBlocking (blockMs * 10);
+
+        expectEquals (int (report.getParameter ("stall-count")), 0);
+        expectEquals (report.getParameter ("stalls").size (), 0);
+        expectEquals (double (report.getParameter ("max-stall-ms")), 0.0);
+    }
+
+    void resetClearsReport ()
+    {
+        auto testCentre = runOnMessageQueue ([] { return TestCentre::create (); });
+
+        {
+            StallMonitor monitor (*testCentre, 50);
+            blockMessageThread ();
+
+            const auto before = getReport (monitor, true);
+            expectGreaterOrEqual (int (before.getParameter ("stall-count")), 1);
+
+            const auto after = getReport (monitor, false);
+            expectEquals (int (after.getParameter ("stall-count")), 0);
+            expectEquals (double (after.getParameter ("max-stall-ms")), 0.0);
+        }
+
+        runOnMessageQueue ([&] { testCentre.reset (); });
+    }
+
+private:
+    [[nodiscard]] static Response getReportAfterBlocking (int thresholdMs)
+    {
+        auto testCentre = runOnMessageQueue ([] { return TestCentre::create (); });
+        auto report = Response::fail ("No report");
+
+        {
+            StallMonitor monitor (*testCentre, thresholdMs);
+            blockMessageThread ();
+            report = getReport (monitor, false);
+        }
+
+        runOnMessageQueue ([&] { testCentre.reset (); });
+        return report;
+    }
+
+    // Waits for a heartbeat to be queued first, so that one is held up for the whole time
+    static void blockMessageThread ()
+    {
+        static constexpr auto settleMs = 50;
+
+        juce::Thread::sleep (settleMs);
+        runOnMessageQueue ([] { juce::Thread::sleep (blockMs); });
+        juce::Thread::sleep (settleMs);
+    }
+
+    [[nodiscard]] static Response getReport (StallMonitor & monitor, bool reset)
+    {
+        auto args = std::make_unique<juce::DynamicObject> ();
+        args->setProperty ("reset", reset);
+
+        const auto response =
+            monitor.process (Command::create ("get-stall-report", args.release ()));
+
+        return response.value_or (Response::fail ("Not handled"));
+    }
+};
+
+[[maybe_unused]] static StallMonitorTests stallMonitorTests;
+
+}
@@ -0,0 +1,105 @@
+#include "../source/Connection.h"
+#include "../source/StartupTimes.h"
+
+namespace focusrite::e2e
+{
+class StartupTests final : public juce::UnitTest
+{
+public:
+    StartupTests () noexcept
+        : juce::UnitTest ("Startup")
+    {
+    }
+
+    void runTest () override
+    {
+        struct Test
+        {
+            juce::String name;
+            std::function<void ()> entry;
+        };
+
+        auto tests = {
+            Test {"Retries until the harness listens", [this] { retriesUntilListening (); }},
+            Test {"Reports the startup times", [this] { reportsStartupTimes (); }},
+            Test {"Parses the start time", [this] { parsesStartTicks (); }},
+        };
+
+        for (auto && test : tests)
+        {
+            beginTest (test.name);
+            test.entry ();
+        }
+    }
+
+    void retriesUntilListening ()
+    {
+        static constexpr auto listenDelayMs = 200;
+        static constexpr auto timeoutMs = 5000;
+
+        // Finds a free port, which is then left closed while the connection starts trying it
+        juce::StreamingSocket listener;
+        expect (listener.createListener (0));
+        const auto port = listener.getBoundPort ();
+        listener.close ();
+
+        std::vector<juce::int64> attemptsMs;
+        juce::WaitableEvent connected;
+
+        auto connection = Connection::create (port, timeoutMs);
+        connection->_onConnected = [&] (auto && connectAttemptsMs)
+        {
+            attemptsMs = connectAttemptsMs;
+            connected.signal ();
+        };
+        connection->start ();
+
+        juce::Thread::sleep (listenDelayMs);
+
+        juce::StreamingSocket lateListener;
+        expect (lateListener.createListener (port));
+        std::unique_ptr<juce::StreamingSocket> harness (
+            lateListener.waitUntilReady (true, timeoutMs) == 1
+                ? lateListener.waitForNextConnection ()
+                : nullptr);
+
+        expect (harness != nullptr);
+        expect (connected.wait (timeoutMs));
+        expectGreaterThan (int (attemptsMs.size ()), 1);
+        expect (std::is_sorted (attemptsMs.begin (), attemptsMs.end ()));
+
+        connection->stop ();
+    }
+
+    void reportsStartupTimes ()
+    {
+        const auto nowMs = juce::Time::currentTimeMillis ();
+        const auto data =
+            StartupTimes::createHandshake (nowMs - 10, {nowMs - 5, nowMs - 1}).getData ();
+
+        // /proc only reports the start to the nearest clock tick
+        static constexpr auto clockTickMs = 100;
+
+        const auto processStartMs = juce::int64 (data ["process-start-ms"]);
+        expectLessOrEqual (processStartMs, nowMs + clockTickMs);
+        expectGreaterThan (processStartMs, juce::int64 (0));
+        expectEquals (juce::int64 (data ["test-centre-created-ms"]), nowMs - 10);
+        expectEquals (data ["connect-attempts-ms"].size (), 2);
+        expectGreaterOrEqual (juce::int64 (data ["ready-ms"]), nowMs);
+    }
+
+    void parsesStartTicks ()
+    {
+        const auto ticks = StartupTimes::parseStartTicks (
+            "1234 (my app) (x)) S 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 5678 19 20\n");
+
+        expect (ticks.has_value ());
+        expectEquals (ticks.value_or (0), juce::int64 (5678));
+        expect (! StartupTimes::parseStartTicks ("1234 (app) S 1 2").has_value ());
+        expect (! StartupTimes::parseStartTicks ({}).has_value ());
+    }
+};
+
+[[maybe_unused]] static StartupTests startupTests;
+
+}
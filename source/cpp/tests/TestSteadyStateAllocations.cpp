@@ -0,0 +1,200 @@
+#include "../source/AllocationTracker.h"
+#include "../source/CommandParser.h"
+#include "../source/ConnectedTestCentre.h"
+#include "TestHelpers.h"
+
+#include <focusrite/e2e/ComponentSearch.h>
+
+namespace focusrite::e2e
+{
+struct QueriedWindow
+{
+    QueriedWindow ()
+    {
+        ComponentSearch::setTestId (component, "queried");
+        component.setBounds (0, 0, 10, 10);
+        window.addAndMakeVisible (component);
+        window.setVisible (true);
+    }
+
+    juce::TopLevelWindow window {"window", true};
+    juce::Component component;
+};
+
+class SteadyStateAllocationsTests final : public juce::UnitTest
+{
+public:
+    SteadyStateAllocationsTests () noexcept
+        : juce::UnitTest ("SteadyStateAllocations")
+    {
+    }
+
+    void runTest () override
+    {
+        struct Test
+        {
+            juce::String name;
+            std::function<void ()> entry;
+        };
+
+        auto tests = {
+            Test {"Parses commands as juce::JSON does", [this] { parsesCommandsAsJson (); }},
+            Test {"Reuses parsed arguments", [this] { reusesParsedArguments (); }},
+            Test {"Answers queries without allocating", [this] { answersWithoutAllocating (); }},
+        };
+
+        for (auto && test : tests)
+        {
+            beginTest (test.name);
+            test.entry ();
+        }
+    }
+
+    void parsesCommandsAsJson ()
+    {
+        for (const juce::String json :
+             {R"({"type":"click","uuid":"beb16073-dbcd-49aa-b7d1-9466582a1e0e"})",
+              R"({"type": "key", "uuid": "beb16073dbcd49aab7d19466582a1e0e", "args": {}})",
+              R"({"args": {"id": "a", "n": 3, "big": 5000000000, "x": -1.5e2, "on": true,
+                           "off": false, "none": null},
+                  "type": "t", "uuid": "beb16073-dbcd-49aa-b7d1-9466582a1e0e"})",
+              R"({"type": "t", "uuid": "beb16073-dbcd-49aa-b7d1-9466582a1e0e",
+                  "args": {"text": "café \"quoted\"", "nested": {"a": [1, 2]}}})",
+              R"({"type": "t", "uuid": "beb16073-dbcd-49aa-b7d1-9466582a1e0e", "args": {"a": 1,
+                  "a": 2}})"})
+        {
+            CommandParser parser;
+            const auto parsed = parser.parse (json.toRawUTF8 (), json.getNumBytesAsUTF8 ());
+            const auto expected = Command::fromJson (json);
+
+            expectEquals (parsed.getType (), expected.getType ());
+            expect (parsed.getUuid () == expected.getUuid ());
+            expectEquals (juce::JSON::toString (parsed.getArgs (), true),
+                          juce::JSON::toString (expected.getArgs (), true));
+        }
+    }
+
+    void reusesParsedArguments ()
+    {
+        CommandParser parser;
+
+        const auto parse = [&] (const juce::String & json)
+        { return parser.parse (json.toRawUTF8 (), json.getNumBytesAsUTF8 ()); };
+
+        auto * first = parse (R"({"type":"t","uuid":"beb16073dbcd49aab7d19466582a1e0e",)"
+                              R"("args":{"component-id":"a"}})")
+                           .getArgs ()
+                           .getDynamicObject ();
+
+        const auto second = parse (R"({"type":"t","uuid":"beb16073dbcd49aab7d19466582a1e0e",)"
+                                   R"("args":{"component-id":"b","skip":1}})");
+
+        expect (second.getArgs ().getDynamicObject () == first);
+        expectEquals (second.getArgument ("component-id"), juce::String ("b"));
+        expectEquals (int (second.getArgumentAsVar ("skip")), 1);
+
+        const auto held = parse (R"({"type":"t","uuid":"beb16073dbcd49aab7d19466582a1e0e",)"
+                                 R"("args":{"component-id":"c"}})");
+        const auto third = parse (R"({"type":"t","uuid":"beb16073dbcd49aab7d19466582a1e0e",)"
+                                  R"("args":{"component-id":"d"}})");
+
+        expect (third.getArgs ().getDynamicObject () != held.getArgs ().getDynamicObject ());
+        expectEquals (held.getArgument ("component-id"), juce::String ("c"));
+        expect (held.getArgumentAsVar ("skip").isVoid ());
+    }
+
+    // Once everything on the path has seen a command like this one, the library's part of
+    // answering it, from reading the socket to writing the response, shouldn't allocate
+    void answersWithoutAllocating ()
+    {
+        static constexpr auto numWarmUpQueries = 50;
+        static constexpr auto numQueries = 200;
+
+        juce::StreamingSocket listener;
+        expect (listener.createListener (0));
+
+        std::unique_ptr<QueriedWindow> window;
+        std::unique_ptr<TestCentre> testCentre;
+
+        runOnMessageQueue (
+            [&]
+            {
+                window = std::make_unique<QueriedWindow> ();
+                testCentre = createConnectedTestCentre (listener.getBoundPort ());
+            });
+
+        std::unique_ptr<juce::StreamingSocket> harness;
+        if (listener.waitUntilReady (true, acceptTimeoutMs) == 1)
+            harness.reset (listener.waitForNextConnection ());
+
+        expect (harness != nullptr);
+
+        if (harness != nullptr)
+        {
+            // The app introduces itself before reading any command
+            const auto handshake = readJsonFrame (*harness);
+            expectEquals (handshake ["type"].toString (), juce::String ("event"));
+            expectEquals (handshake ["name"].toString (), juce::String ("handshake"));
+
+            for (int query = 0; query < numWarmUpQueries; ++query)
+                expect (isShowing (queryVisibility (*harness)));
+
+            const auto start = roundTrip (*harness, "start-allocation-tracking");
+
+            auto numShowing = 0;
+            for (int query = 0; query < numQueries; ++query)
+                numShowing += isShowing (queryVisibility (*harness)) ? 1 : 0;
+
+            const auto stop = roundTrip (*harness, "stop-allocation-tracking");
+            expectEquals (numShowing, numQueries);
+
+            if (AllocationTracker::isAvailable ())
+            {
+                expect (bool (start ["success"]));
+
+                const auto command = stop ["data"]["commands"]["get-component-visibility"];
+                expectGreaterThan (int (command ["count"]), 0);
+                expectEquals (int (command ["library"]["allocations"]), 0);
+            }
+            else
+            {
+                logMessage ("Allocations aren't counted without FOCUSRITE_E2E_ALLOCATION_TRACKING");
+            }
+
+            harness->close ();
+        }
+
+        runOnMessageQueue (
+            [&]
+            {
+                testCentre.reset ();
+                window.reset ();
+            });
+    }
+
+private:
+    [[nodiscard]] static juce::var queryVisibility (juce::StreamingSocket & harness)
+    {
+        return roundTrip (harness, "get-component-visibility", R"({"component-id":"queried"})");
+    }
+
+    [[nodiscard]] static juce::var roundTrip (juce::StreamingSocket & harness,
+                                              const juce::String & type,
+                                              const juce::String & args = "{}")
+    {
+        const auto json = R"({"type":")" + type + R"(","uuid":")" +
+                          juce::Uuid ().toDashedString () + R"(","args":)" + args + "}";
+
+        return writeFrame (harness, json) ? readJsonFrame (harness) : juce::var ();
+    }
+
+    [[nodiscard]] static bool isShowing (const juce::var & response)
+    {
+        return bool (response ["success"]) && bool (response ["data"]["exists"]) &&
+               bool (response ["data"]["showing"]);
+    }
+};
+
+[[maybe_unused]] static SteadyStateAllocationsTests steadyStateAllocationsTests;
+
+}
@@ -0,0 +1,173 @@
+#include "TestHelpers.h"
+
+#include <focusrite/e2e/TestCentre.h>
+#include <future>
+#include <juce_events/juce_events.h>
+
+namespace focusrite::e2e
+{
+class MessageThreadHandler final : public CommandHandler
+{
+public:
+    std::optional<Response> process (const Command & command) override
+    {
+        if (command.getType () != "where-am-i")
+            return std::nullopt;
+
+        return Response::ok ().withParameter ("message-thread",
+                                              juce::MessageManager::existsAndIsCurrentThread ());
+    }
+};
+
+class DeferredHandler final : public AsyncCommandHandler
+{
+public:
+    bool process (const Command & command, std::shared_ptr<Responder> responder) override
+    {
+        if (command.getType () != "deferred")
+            return false;
+
+        juce::MessageManager::callAsync ([responder]
+                                         { responder->respond (Response::ok ()); });
+        return true;
+    }
+};
+
+class SubmitTests final : public juce::UnitTest
+{
+public:
+    SubmitTests () noexcept
+        : juce::UnitTest ("TestCentre::submit")
+    {
+    }
+
+    void runTest () override
+    {
+        struct Test
+        {
+            juce::String name;
+            std::function<void ()> entry;
+        };
+
+        auto tests = {
+            Test {"Responds without a connection", [this] { respondsWithoutConnection (); }},
+            Test {"Response carries the command UUID", [this] { responseCarriesUuid (); }},
+            Test {"Fails unhandled commands", [this] { failsUnhandledCommands (); }},
+            Test {"Runs handlers on the message thread when submitted from another thread",
+                  [this] { runsHandlersOnMessageThread (); }},
+            Test {"Resolves asynchronous handlers", [this] { resolvesAsynchronousHandlers (); }},
+            Test {"Answers quit without quitting", [this] { answersQuitWithoutQuitting (); }},
+        };
+
+        for (auto && test : tests)
+        {
+            beginTest (test.name);
+            test.entry ();
+        }
+    }
+
+    void respondsWithoutConnection ()
+    {
+        runOnMessageQueue (
+            [this]
+            {
+                auto testCentre = TestCentre::create ();
+                auto response = testCentre->submit (Command::create ("get-metrics"));
+
+                expect (isReady (response));
+
+                const auto result = response.get ();
+                expect (result.getResult ().wasOk ());
+                expect (result.getParameter ("commands").isObject ());
+            });
+    }
+
+    void responseCarriesUuid ()
+    {
+        runOnMessageQueue (
+            [this]
+            {
+                auto testCentre = TestCentre::create ();
+                const auto command = Command::create ("get-metrics");
+
+                expect (testCentre->submit (command).get ().getUuid () == command.getUuid ());
+            });
+    }
+
+    void failsUnhandledCommands ()
+    {
+        runOnMessageQueue (
+            [this]
+            {
+                auto testCentre = TestCentre::create ();
+                const auto result = testCentre->submit (Command::create ("not-a-command")).get ();
+
+                expect (result.getResult ().failed ());
+                expectEquals (result.getResult ().getErrorMessage (),
+                              juce::String ("Unhandled message"));
+            });
+    }
+
+    void runsHandlersOnMessageThread ()
+    {
+        MessageThreadHandler handler;
+        auto testCentre = runOnMessageQueue (
+            [&]
+            {
+                auto created = TestCentre::create ();
+                created->addCommandHandler (handler);
+                return created;
+            });
+
+        auto response = testCentre->submit (Command::create ("where-am-i"));
+
+        expect (response.wait_for (std::chrono::seconds (5)) == std::future_status::ready);
+        expect (bool (response.get ().getParameter ("message-thread")));
+
+        runOnMessageQueue ([&] { testCentre.reset (); });
+    }
+
+    void resolvesAsynchronousHandlers ()
+    {
+        DeferredHandler handler;
+        auto testCentre = runOnMessageQueue (
+            [&]
+            {
+                auto created = TestCentre::create ();
+                created->addAsyncCommandHandler (handler);
+                return created;
+            });
+
+        auto response = runOnMessageQueue (
+            [&] { return testCentre->submit (Command::create ("deferred")); });
+
+        expect (response.wait_for (std::chrono::seconds (5)) == std::future_status::ready);
+        expect (response.get ().getResult ().wasOk ());
+
+        runOnMessageQueue ([&] { testCentre.reset (); });
+    }
+
+    void answersQuitWithoutQuitting ()
+    {
+        auto testCentre = runOnMessageQueue ([] { return TestCentre::create (); });
+
+        const auto result =
+            runOnMessageQueue ([&] { return testCentre->submit (Command::create ("quit")).get (); });
+
+        expect (result.getResult ().wasOk ());
+
+        // The app would quit from a message posted while the command was answered
+        runOnMessageQueue ([&] { testCentre.reset (); });
+        expect (! juce::MessageManager::getInstance ()->hasStopMessageBeenSent ());
+    }
+
+private:
+    [[nodiscard]] static bool isReady (const std::future<Response> & response)
+    {
+        return response.wait_for (std::chrono::seconds (0)) == std::future_status::ready;
+    }
+};
+
+[[maybe_unused]] static SubmitTests submitTests;
+
+}
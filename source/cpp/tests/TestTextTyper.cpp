@@ -0,0 +1,172 @@
+#include "TestHelpers.h"
+
+#include <focusrite/e2e/ComponentSearch.h>
+#include <focusrite/e2e/TestCentre.h>
+#include <future>
+#include <juce_gui_basics/juce_gui_basics.h>
+
+namespace focusrite::e2e
+{
+struct TypingWindow
+{
+    TypingWindow ()
+    {
+        ComponentSearch::setTestId (*editor, "editor");
+        ComponentSearch::setTestId (label, "label");
+        editor->setBounds (0, 0, 100, 20);
+        label.setBounds (0, 20, 100, 20);
+        window.addAndMakeVisible (*editor);
+        window.addAndMakeVisible (label);
+        window.setVisible (true);
+    }
+
+    juce::TopLevelWindow window {"window", true};
+    std::unique_ptr<juce::TextEditor> editor = std::make_unique<juce::TextEditor> ();
+    juce::Label label;
+};
+
+class TextTyperTests final : public juce::UnitTest
+{
+public:
+    TextTyperTests () noexcept
+        : juce::UnitTest ("TextTyper")
+    {
+    }
+
+    void runTest () override
+    {
+        struct Test
+        {
+            juce::String name;
+            std::function<void ()> entry;
+        };
+
+        auto tests = {
+            Test {"Types without a delay", [this] { typesWithoutDelay (); }},
+            Test {"Types with a delay", [this] { typesWithDelay (); }},
+            Test {"Inserts into a TextEditor", [this] { insertsIntoTextEditor (); }},
+            Test {"Only inserts into a TextEditor", [this] { onlyInsertsIntoTextEditor (); }},
+            Test {"Fails if the target is deleted", [this] { failsIfTargetDeleted (); }},
+        };
+
+        for (auto && test : tests)
+        {
+            beginTest (test.name);
+            test.entry ();
+        }
+    }
+
+    void typesWithoutDelay ()
+    {
+        create ();
+
+        const auto result = typeText (R"({"component-id": "editor", "text": "Hello"})").get ();
+
+        expect (result.getResult ().wasOk ());
+        expectEquals (int (result.getParameter ("typed")), 5);
+        expectEquals (getEditorText (), juce::String ("Hello"));
+
+        destroy ();
+    }
+
+    void typesWithDelay ()
+    {
+        create ();
+
+        const auto result =
+            typeText (R"({"component-id": "editor", "text": "abc", "delay-ms": 20})").get ();
+
+        expect (result.getResult ().wasOk ());
+        expectEquals (int (result.getParameter ("typed")), 3);
+        expectGreaterOrEqual (double (result.getParameter ("duration-ms")), 40.0);
+        expectEquals (getEditorText (), juce::String ("abc"));
+
+        destroy ();
+    }
+
+    void insertsIntoTextEditor ()
+    {
+        create ();
+
+        const auto args = R"({"component-id": "editor", "text": "caf\u00e9", "method": "insert"})";
+        const auto result = typeText (args).get ();
+
+        expect (result.getResult ().wasOk ());
+        expectEquals (int (result.getParameter ("typed")), 4);
+        expectEquals (getEditorText (), juce::String::fromUTF8 ("café"));
+
+        destroy ();
+    }
+
+    void onlyInsertsIntoTextEditor ()
+    {
+        create ();
+
+        const auto result =
+            typeText (R"({"component-id": "label", "text": "x", "method": "insert"})").get ();
+
+        expect (result.getResult ().failed ());
+        expectEquals (result.getResult ().getErrorMessage (),
+                      juce::String ("Can only insert text into a TextEditor"));
+
+        destroy ();
+    }
+
+    // The first character is typed straight away and the rest from a timer, which then finds
+    // the editor gone
+    void failsIfTargetDeleted ()
+    {
+        create ();
+
+        auto response =
+            typeText (R"({"component-id": "editor", "text": "abcdef", "delay-ms": 50})");
+        runOnMessageQueue ([&] { _window->editor.reset (); });
+
+        expect (response.wait_for (std::chrono::seconds (5)) == std::future_status::ready);
+
+        const auto result = response.get ();
+        expect (result.getResult ().failed ());
+        expectEquals (result.getResult ().getErrorMessage (),
+                      juce::String ("Component deleted while typing"));
+
+        destroy ();
+    }
+
+private:
+    void create ()
+    {
+        runOnMessageQueue (
+            [&]
+            {
+                _window = std::make_unique<TypingWindow> ();
+                _testCentre = TestCentre::create ();
+            });
+    }
+
+    void destroy ()
+    {
+        runOnMessageQueue (
+            [&]
+            {
+                _testCentre.reset ();
+                _window.reset ();
+            });
+    }
+
+    [[nodiscard]] std::future<Response> typeText (const juce::String & args)
+    {
+        return _testCentre->submit (Command::create ("type-text", juce::JSON::parse (args)));
+    }
+
+    [[nodiscard]] juce::String getEditorText ()
+    {
+        return runOnMessageQueue ([&] { return _window->editor->getText (); });
+    }
+
+    std::unique_ptr<TypingWindow> _window;
+    std::unique_ptr<TestCentre> _testCentre;
+};
+
+[[maybe_unused]] static TextTyperTests textTyperTests;
+
+}
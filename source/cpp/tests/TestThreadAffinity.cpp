@@ -0,0 +1,175 @@
+#include "TestHelpers.h"
+
+#include <focusrite/e2e/TestCentre.h>
+#include <future>
+#include <juce_events/juce_events.h>
+
+namespace focusrite::e2e
+{
+// Answers "any-thread" wherever it's called and "message-thread" on the message thread, noting
+// the order in which the latter arrive
+class AffinityHandler final : public CommandHandler
+{
+public:
+    std::optional<Response> process (const Command & command) override
+    {
+        if (command.getType () == "message-thread")
+            _order.push_back (int (command.getArgumentAsVar ("index")));
+        else if (command.getType () != "any-thread")
+            return std::nullopt;
+
+        return Response::ok ().withParameter ("message-thread",
+                                              juce::MessageManager::existsAndIsCurrentThread ());
+    }
+
+    [[nodiscard]] ThreadAffinity getThreadAffinity (const Command & command) const override
+    {
+        return command.getType () == "any-thread" ? ThreadAffinity::anyThread
+                                                  : ThreadAffinity::messageThread;
+    }
+
+    std::vector<int> _order;
+};
+
+class ThreadAffinityTests final : public juce::UnitTest
+{
+public:
+    ThreadAffinityTests () noexcept
+        : juce::UnitTest ("ThreadAffinity")
+    {
+    }
+
+    void runTest () override
+    {
+        struct Test
+        {
+            juce::String name;
+            std::function<void ()> entry;
+        };
+
+        auto tests = {
+            Test {"Any-thread commands are answered inline", [this] { anyThreadIsInline (); }},
+            Test {"Message-thread commands run on the message thread",
+                  [this] { messageThreadRunsThere (); }},
+            Test {"Message-thread commands keep their order", [this] { keepsOrder (); }},
+            Test {"Keeps the order while the message thread is blocked",
+                  [this] { keepsOrderWhileBlocked (); }},
+        };
+
+        for (auto && test : tests)
+        {
+            beginTest (test.name);
+            test.entry ();
+        }
+    }
+
+    void anyThreadIsInline ()
+    {
+        AffinityHandler handler;
+        auto testCentre = create (handler);
+
+        auto response = testCentre->submit (Command::create ("any-thread"));
+
+        expect (response.wait_for (std::chrono::seconds (0)) == std::future_status::ready);
+        expect (! bool (response.get ().getParameter ("message-thread")));
+
+        runOnMessageQueue ([&] { testCentre.reset (); });
+    }
+
+    void messageThreadRunsThere ()
+    {
+        AffinityHandler handler;
+        auto testCentre = create (handler);
+
+        auto response = testCentre->submit (createIndexedCommand (0));
+
+        expect (response.wait_for (std::chrono::seconds (5)) == std::future_status::ready);
+        expect (bool (response.get ().getParameter ("message-thread")));
+
+        runOnMessageQueue ([&] { testCentre.reset (); });
+    }
+
+    void keepsOrder ()
+    {
+        AffinityHandler handler;
+        auto testCentre = create (handler);
+
+        expectInOrder (handler, submitIndexedCommands (*testCentre, 32));
+
+        runOnMessageQueue ([&] { testCentre.reset (); });
+    }
+
+    // More commands than the queue to the message thread holds
+    void keepsOrderWhileBlocked ()
+    {
+        AffinityHandler handler;
+        auto testCentre = create (handler);
+
+        juce::WaitableEvent blocked;
+        juce::WaitableEvent release;
+
+        juce::MessageManager::callAsync (
+            [&]
+            {
+                blocked.signal ();
+                release.wait ();
+            });
+
+        expect (blocked.wait (5000));
+        auto responses = submitIndexedCommands (*testCentre, 200);
+        release.signal ();
+
+        expectInOrder (handler, std::move (responses));
+
+        runOnMessageQueue ([&] { testCentre.reset (); });
+    }
+
+private:
+    [[nodiscard]] static std::unique_ptr<TestCentre> create (AffinityHandler & handler)
+    {
+        return runOnMessageQueue (
+            [&]
+            {
+                auto created = TestCentre::create ();
+                created->addCommandHandler (handler);
+                return created;
+            });
+    }
+
+    [[nodiscard]] static Command createIndexedCommand (int index)
+    {
+        auto args = std::make_unique<juce::DynamicObject> ();
+        args->setProperty ("index", index);
+        return Command::create ("message-thread", args.release ());
+    }
+
+    [[nodiscard]] static std::vector<std::future<Response>>
+    submitIndexedCommands (TestCentre & testCentre, int numCommands)
+    {
+        std::vector<std::future<Response>> responses;
+
+        for (auto index = 0; index < numCommands; ++index)
+            responses.push_back (testCentre.submit (createIndexedCommand (index)));
+
+        return responses;
+    }
+
+    void expectInOrder (const AffinityHandler & handler,
+                        std::vector<std::future<Response>> responses)
+    {
+        for (auto & response : responses)
+            expect (response.wait_for (std::chrono::seconds (5)) == std::future_status::ready);
+
+        // Read on the message thread, which wrote it
+        const auto order = runOnMessageQueue ([&] { return handler._order; });
+
+        expectEquals (int (order.size ()), int (responses.size ()));
+
+        for (auto index = 0; index < int (order.size ()); ++index)
+            expectEquals (order [size_t (index)], index);
+    }
+};
+
+[[maybe_unused]] static ThreadAffinityTests threadAffinityTests;
+
+}
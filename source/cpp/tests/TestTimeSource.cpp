@@ -0,0 +1,132 @@
+#include "../source/VirtualClock.h"
+
+namespace focusrite::e2e
+{
+class TimeSourceTests final : public juce::UnitTest
+{
+public:
+    TimeSourceTests () noexcept
+        : juce::UnitTest ("TimeSource")
+    {
+    }
+
+    void runTest () override
+    {
+        struct Test
+        {
+            juce::String name;
+            std::function<void ()> entry;
+        };
+
+        auto tests = {
+            Test {"Follows real time by default", [this] { followsRealTime (); }},
+            Test {"Stops at a scale of zero", [this] { stopsAtScaleOfZero (); }},
+            Test {"Advances in steps", [this] { advancesInSteps (); }},
+            Test {"Speeds up with the scale", [this] { speedsUpWithScale (); }},
+            Test {"Commands fail unless enabled", [this] { commandsFailUnlessEnabled (); }},
+            Test {"Commands reject invalid arguments", [this] { commandsRejectInvalid (); }},
+        };
+
+        for (auto && test : tests)
+        {
+            beginTest (test.name);
+            test.entry ();
+        }
+    }
+
+    void followsRealTime ()
+    {
+        const TimeSource timeSource;
+
+        const auto before = juce::Time::getMillisecondCounterHiRes ();
+        const auto now = timeSource.getMillisecondCounterHiRes ();
+        const auto after = juce::Time::getMillisecondCounterHiRes ();
+
+        expect (before <= now && now <= after);
+        expectEquals (timeSource.getScale (), 1.0);
+    }
+
+    void stopsAtScaleOfZero ()
+    {
+        TimeSource timeSource;
+        timeSource.setScale (0.0);
+
+        const auto stopped = timeSource.getMillisecondCounterHiRes ();
+        juce::Thread::sleep (sleepMs);
+
+        expectEquals (timeSource.getMillisecondCounterHiRes (), stopped);
+    }
+
+    void advancesInSteps ()
+    {
+        TimeSource timeSource;
+        timeSource.setScale (0.0);
+
+        const auto start = timeSource.getMillisecondCounterHiRes ();
+        timeSource.advance (1500.0);
+
+        expectEquals (timeSource.getMillisecondCounterHiRes () - start, 1500.0);
+
+        timeSource.advance (-100.0);
+        expectEquals (timeSource.getMillisecondCounterHiRes () - start, 1500.0);
+    }
+
+    void speedsUpWithScale ()
+    {
+        TimeSource timeSource;
+        timeSource.setScale (10.0);
+
+        const auto start = timeSource.getMillisecondCounterHiRes ();
+        const auto realStart = juce::Time::getMillisecondCounterHiRes ();
+        juce::Thread::sleep (sleepMs);
+        const auto realElapsed = juce::Time::getMillisecondCounterHiRes () - realStart;
+
+        expectGreaterOrEqual (timeSource.getMillisecondCounterHiRes () - start,
+                              realElapsed * 10.0);
+    }
+
+    void commandsFailUnlessEnabled ()
+    {
+        TimeSource timeSource;
+        VirtualClock clock (timeSource, false);
+
+        const auto response = clock.process (createCommand ("advance-time", "ms", 100));
+
+        expect (response.has_value ());
+        expect (response->getResult ().failed ());
+        expectEquals (timeSource.getScale (), 1.0);
+    }
+
+    void commandsRejectInvalid ()
+    {
+        TimeSource timeSource;
+        VirtualClock clock (timeSource, true);
+
+        expect (clock.process (createCommand ("advance-time", "ms", -1))->getResult ().failed ());
+        expect (clock.process (createCommand ("advance-time", "ms", {}))->getResult ().failed ());
+        expect (clock.process (createCommand ("set-time-scale", "scale", -2.0))
+                    ->getResult ()
+                    .failed ());
+
+        const auto response = clock.process (createCommand ("set-time-scale", "scale", 0));
+        expect (response->getResult ().wasOk ());
+        expectEquals (double (response->getParameter ("scale")), 0.0);
+        expect (! clock.process (createCommand ("get-time", "ms", 0)).has_value ());
+    }
+
+private:
+    static constexpr auto sleepMs = 20;
+
+    [[nodiscard]] static Command createCommand (const juce::String & type,
+                                                const juce::String & argument,
+                                                const juce::var & value)
+    {
+        auto args = std::make_unique<juce::DynamicObject> ();
+        args->setProperty (argument, value);
+        return Command::create (type, args.release ());
+    }
+};
+
+[[maybe_unused]] static TimeSourceTests timeSourceTests;
+
+}
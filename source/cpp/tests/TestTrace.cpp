@@ -0,0 +1,140 @@
+#include "../source/Tracer.h"
+
+#include <focusrite/e2e/Trace.h>
+
+namespace focusrite::e2e
+{
+class TraceTests final : public juce::UnitTest
+{
+public:
+    TraceTests () noexcept
+        : juce::UnitTest ("Trace")
+    {
+    }
+
+    void runTest () override
+    {
+        struct Test
+        {
+            juce::String name;
+            std::function<void ()> entry;
+        };
+
+        auto tests = {
+            Test {"Records spans from each thread", [this] { recordsSpansFromEachThread (); }},
+            Test {"Keeps the latest events of each thread", [this] { keepsLatestEvents (); }},
+            Test {"Stops recording when stopped", [this] { stopsRecording (); }},
+        };
+
+        for (auto && test : tests)
+        {
+            beginTest (test.name);
+            test.entry ();
+        }
+    }
+
+    void recordsSpansFromEachThread ()
+    {
+        const juce::TemporaryFile file (".json");
+        Tracer::start (file.getFile ());
+
+        {
+            const ScopedTrace trace ("outer", "detail");
+            Trace::begin ("inner");
+            Trace::end ();
+        }
+
+        juce::WaitableEvent workerDone;
+        juce::Thread::launch (
+            [&]
+            {
+                {
+                    const ScopedTrace trace ("worker");
+                }
+
+                workerDone.signal ();
+            });
+
+        expect (workerDone.wait (5000));
+
+        expect (Tracer::flush ().wasOk ());
+        Tracer::stop ();
+
+        const auto events = juce::JSON::parse (file.getFile ()) ["traceEvents"];
+        juce::StringArray names;
+        juce::SortedSet<int> threads;
+
+        for (const auto & event : events)
+        {
+            threads.add (int (event ["tid"]));
+
+            if (event ["ph"] == "B")
+                names.add (event ["name"].toString ());
+        }
+
+        expectEquals (names.joinIntoString (","), juce::String ("outer,inner,worker"));
+        expectEquals (threads.size (), 2);
+    }
+
+    void keepsLatestEvents ()
+    {
+        const juce::TemporaryFile file (".json");
+        Tracer::start (file.getFile ());
+
+        Trace::begin ("first");
+
+        for (auto index = 0; index < 40000; ++index)
+            const ScopedTrace trace ("repeat");
+
+        Trace::end ();
+
+        expect (Tracer::flush ().wasOk ());
+        Tracer::stop ();
+
+        const auto events = juce::JSON::parse (file.getFile ()) ["traceEvents"];
+        auto numDropped = 0;
+        auto numBegins = 0;
+        auto numEnds = 0;
+        juce::StringArray names;
+
+        for (const auto & event : events)
+        {
+            if (event ["ph"] == "M")
+            {
+                numDropped = event ["args"]["dropped"];
+            }
+            else if (event ["ph"] == "B")
+            {
+                ++numBegins;
+                names.addIfNotAlreadyThere (event ["name"].toString ());
+            }
+            else
+            {
+                ++numEnds;
+            }
+        }
+
+        // Every event but the end of "first", whose begin was overwritten
+        expect (numDropped > 0);
+        expectEquals (numBegins + numEnds + numDropped, 80002 - 1);
+        expectEquals (numBegins, numEnds);
+        expectEquals (names.joinIntoString (","), juce::String ("repeat"));
+    }
+
+    void stopsRecording ()
+    {
+        const juce::TemporaryFile file (".json");
+        Tracer::start (file.getFile ());
+        Tracer::stop ();
+
+        expect (! Trace::isEnabled ());
+        expect (Tracer::flush ().failed ());
+
+        // Ignored rather than written to the released buffers
+        const ScopedTrace trace ("after-stop");
+    }
+};
+
+[[maybe_unused]] static TraceTests traceTests;
+
+}
@@ -9,6 +9,7 @@ import {
   ComponentEnablementResponse,
   ComponentTextResponse,
   ScreenshotResponse,
+  ScreenshotDeltaResponse,
   ComponentCountResponse,
   ResponseData,
   GetSliderValueResponse,
@@ -18,12 +19,44 @@ import {
   AccessibilityChildResponse,
   GetFocusedComponentResponse,
   GetComboBoxItemsResponse,
+  StartCaptureResponse,
+  StopCaptureResponse,
+  CapturedFrame,
+  CaptureResult,
+  EventResponse,
+  HandshakeEvent,
+  MetricsResponse,
+  FlushTraceResponse,
+  StallReport,
+  AppMetricsEvent,
+  AppMetricsResponse,
+  AppMetricsSnapshot,
+  RunScriptResponse,
+  AllocationTrackingResponse,
+  MemoryStatsResponse,
+  PaintProfileResponse,
+  ScriptStepResult,
+  StartupTimes,
+  TimeResponse,
+  WaitForIdleResponse,
 } from './responses';
-import {Command} from './commands';
+import {
+  Command,
+  EventPolicy,
+  GesturePoint,
+  MouseGestureOptions,
+  ScreenshotOptions,
+  ScriptStep,
+  TypeTextOptions,
+  WaitForIdleOptions,
+} from './commands';
 import {minimatch} from 'minimatch';
 import {waitForResult} from './poll';
 import {AppProcess, EnvironmentVariables, launchApp} from './app-process';
 import {ComponentHandle} from './component-handle';
+import {ScreenshotFrame, ScreenshotRecording} from './screenshot-delta';
+import {AppMetricsStream} from './app-metrics';
+import {DEFAULT_EVENT_RETENTION, EventRetention} from './event-store';
 
 const writeFile = util.promisify(fs.writeFile);
 
@@ -32,10 +65,14 @@ let screenshotIndex = 0;
 interface AppConnectionOptions {
   appPath: string;
   logDirectory?: string;
+  eventRetention?: EventRetention;
 }
 
 export const DEFAULT_TIMEOUT = 5000;
 
+// Two minutes at the default frame rate; older frames are dropped beyond this
+const MAX_CAPTURED_FRAMES = 3600;
+
 const existsAsFile = (path: string) => {
   try {
     return fs.statSync(path).isFile();
@@ -50,7 +87,13 @@ export class AppConnection extends EventEmitter {
   server: Server;
   connection?: Connection;
   logDirectory?: string;
+  eventRetention?: EventRetention;
   exitPromise?: Promise<void>;
+  screenshotRecordings: Map<string, ScreenshotRecording>;
+  capturedFrames: CapturedFrame[];
+  appMetrics: AppMetricsStream;
+  launchMs?: number;
+  handshake?: HandshakeEvent;
 
   constructor(options: AppConnectionOptions) {
     super();
@@ -63,7 +106,11 @@ export class AppConnection extends EventEmitter {
 
     this.appPath = options.appPath;
     this.logDirectory = options.logDirectory;
+    this.eventRetention = options.eventRetention;
     this.server = new Server();
+    this.screenshotRecordings = new Map();
+    this.capturedFrames = [];
+    this.appMetrics = new AppMetricsStream();
 
     this.server.on('error', () => {
       this.stopServer();
@@ -110,11 +157,32 @@ export class AppConnection extends EventEmitter {
 
   async launch(extraArgs: string[] = [], env: EnvironmentVariables = {}) {
     const port = await this.server.listen();
+    this.launchMs = Date.now();
+    this.handshake = undefined;
     this.launchProcess(extraArgs.concat([`--e2e-test-port=${port}`]), env);
     const socket = await this.server.waitForConnection();
 
-    this.connection = new Connection(socket);
+    // Frames are kept in capturedFrames, so the store only needs the latest
+    // one for stopCapture to wait on
+    const eventRetention = this.eventRetention ?? DEFAULT_EVENT_RETENTION;
+    this.connection = new Connection(socket, {
+      ...eventRetention,
+      maxEventsByName: {...eventRetention.maxEventsByName, 'capture-frame': 1},
+    });
     this.connection.on('connect', () => this.emit('connect'));
+    this.connection.on('event', (event: EventResponse) => {
+      if (event.name === 'capture-frame') {
+        this.capturedFrames.push(event.data as CapturedFrame);
+
+        if (this.capturedFrames.length > MAX_CAPTURED_FRAMES) {
+          this.capturedFrames.shift();
+        }
+      } else if (event.name === 'app-metrics') {
+        this.appMetrics.push(event.data as AppMetricsEvent);
+      } else if (event.name === 'handshake') {
+        this.handshake = event.data as HandshakeEvent;
+      }
+    });
     this.connection.on('disconnect', () => {
       this.server.close();
       this.connection = undefined;
@@ -209,6 +277,101 @@ export class AppConnection extends EventEmitter {
     });
   }
 
+  async typeText(text: string, options: TypeTextOptions = {}): Promise<void> {
+    await this.sendCommand({
+      type: 'type-text',
+      args: {
+        text,
+        'component-id': options.componentId || '',
+        'window-id': options.windowId || '',
+        'delay-ms': options.delayMs || 0,
+        'method': options.method || 'key-press',
+      },
+    });
+  }
+
+  async mouseGesture(
+    componentId: string,
+    points: GesturePoint[],
+    options: MouseGestureOptions = {}
+  ): Promise<void> {
+    await this.sendCommand({
+      type: 'mouse-gesture',
+      args: {
+        'component-id': componentId,
+        'window-id': options.windowId || '',
+        'step-ms': options.stepMs,
+        'instant': options.instant || false,
+        'points': points.map((point) => ({
+          'x': point.x,
+          'y': point.y,
+          'time-ms': point.timeMs,
+          'buttons': point.buttons || '',
+          'modifiers': point.modifiers || '',
+          'wheel-x': point.wheelX || 0,
+          'wheel-y': point.wheelY || 0,
+        })),
+      },
+    });
+  }
+
+  async drag(
+    componentId: string,
+    from: {x: number; y: number},
+    to: {x: number; y: number},
+    durationMs = 200
+  ): Promise<void> {
+    await this.mouseGesture(componentId, [
+      {...from, timeMs: 0},
+      {...from, timeMs: 0, buttons: 'left'},
+      {...to, timeMs: durationMs, buttons: 'left'},
+      {...to, timeMs: durationMs},
+    ]);
+  }
+
+  async waitForIdle(
+    options: WaitForIdleOptions = {}
+  ): Promise<WaitForIdleResponse> {
+    return (await this.sendCommand({
+      type: 'wait-for-idle',
+      args: {
+        'quiet-ms': options.quietMs,
+        'timeout-ms': options.timeoutMs,
+      },
+    })) as WaitForIdleResponse;
+  }
+
+  async advanceTime(ms: number): Promise<TimeResponse> {
+    return (await this.sendCommand({
+      type: 'advance-time',
+      args: {ms},
+    })) as TimeResponse;
+  }
+
+  async setTimeScale(scale: number): Promise<TimeResponse> {
+    return (await this.sendCommand({
+      type: 'set-time-scale',
+      args: {scale},
+    })) as TimeResponse;
+  }
+
+  async runScript(steps: ScriptStep[]): Promise<ScriptStepResult[]> {
+    const response = (await this.sendCommand({
+      type: 'run-script',
+      args: {
+        steps: steps.map((step) => ({
+          'type': step.type,
+          'args': step.args || {},
+          'expect': step.expect,
+          'wait': step.wait || false,
+          'timeout-ms': step.timeoutMs,
+        })),
+      },
+    })) as RunScriptResponse;
+
+    return response.steps;
+  }
+
   async setSliderValue(sliderId: string, value: number): Promise<void> {
     await this.sendCommand({
       type: 'set-slider-value',
@@ -426,7 +589,8 @@ export class AppConnection extends EventEmitter {
 
   async saveScreenshot(
     componentId: string,
-    outFileName: string
+    outFileName: string,
+    options: ScreenshotOptions = {}
   ): Promise<void> {
     if (!this.logDirectory) {
       console.error(
@@ -439,6 +603,9 @@ export class AppConnection extends EventEmitter {
       type: 'get-screenshot',
       args: {
         'component-id': componentId,
+        'region': options.region,
+        'scale': options.scale,
+        'max-size': options.maxSize,
       },
     })) as ScreenshotResponse;
 
@@ -452,6 +619,204 @@ export class AppConnection extends EventEmitter {
     }
   }
 
+  async getScreenshotDelta(
+    componentId: string,
+    keyframe = false,
+    options: ScreenshotOptions = {}
+  ): Promise<ScreenshotDeltaResponse> {
+    return (await this.sendCommand({
+      type: 'get-screenshot',
+      args: {
+        'component-id': componentId,
+        'mode': 'delta',
+        'keyframe': keyframe,
+        'region': options.region,
+        'scale': options.scale,
+        'max-size': options.maxSize,
+      },
+    })) as ScreenshotDeltaResponse;
+  }
+
+  async recordScreenshotFrame(componentId: string): Promise<number> {
+    let recording = this.screenshotRecordings.get(componentId);
+
+    if (!recording) {
+      recording = new ScreenshotRecording();
+      this.screenshotRecordings.set(componentId, recording);
+    }
+
+    const delta = await this.getScreenshotDelta(
+      componentId,
+      recording.length === 0
+    );
+
+    return recording.push(delta);
+  }
+
+  getRecordedScreenshotFrame(
+    componentId: string,
+    index: number
+  ): ScreenshotFrame {
+    const recording = this.screenshotRecordings.get(componentId);
+
+    if (!recording) {
+      throw new Error(`No screenshots have been recorded for ${componentId}`);
+    }
+
+    return recording.getFrame(index);
+  }
+
+  async startCapture(
+    componentId: string,
+    framesPerSecond = 30,
+    bufferSize?: number
+  ): Promise<number> {
+    this.capturedFrames = [];
+
+    const response = (await this.sendCommand({
+      type: 'start-capture',
+      args: {
+        'component-id': componentId,
+        'fps': framesPerSecond,
+        'buffer-size': bufferSize,
+      },
+    })) as StartCaptureResponse;
+
+    return response['capture-id'];
+  }
+
+  async stopCapture(timeout = DEFAULT_TIMEOUT): Promise<CaptureResult> {
+    const response = (await this.sendCommand({
+      type: 'stop-capture',
+    })) as StopCaptureResponse;
+
+    const captureId = response['capture-id'];
+    const lastIndex = response.captured - 1;
+
+    // The app sends the frames it hasn't sent yet after responding
+    if (lastIndex >= 0) {
+      await this.waitForEvent(
+        'capture-frame',
+        (data) => {
+          const frame = data as CapturedFrame;
+          return frame['capture-id'] === captureId && frame.index === lastIndex;
+        },
+        timeout
+      );
+    }
+
+    const frames = this.capturedFrames.filter(
+      (frame) => frame['capture-id'] === captureId
+    );
+    this.capturedFrames = [];
+
+    return {...response, frames};
+  }
+
+  async startPaintProfile(componentId?: string): Promise<void> {
+    await this.sendCommand({
+      type: 'start-paint-profile',
+      args: {
+        'component-id': componentId || '',
+      },
+    });
+  }
+
+  async stopPaintProfile(
+    maxComponents?: number
+  ): Promise<PaintProfileResponse> {
+    return (await this.sendCommand({
+      type: 'stop-paint-profile',
+      args: {
+        'max-components': maxComponents,
+      },
+    })) as PaintProfileResponse;
+  }
+
+  async getStartupTimes(timeout = DEFAULT_TIMEOUT): Promise<StartupTimes> {
+    if (!this.handshake) {
+      await this.waitForEvent('handshake', undefined, timeout);
+    }
+
+    return {
+      ...(this.handshake as HandshakeEvent),
+      'launch-ms': this.launchMs as number,
+    };
+  }
+
+  async getMemoryStats(): Promise<MemoryStatsResponse> {
+    return (await this.sendCommand({
+      type: 'get-memory-stats',
+    })) as MemoryStatsResponse;
+  }
+
+  async startAllocationTracking(): Promise<void> {
+    await this.sendCommand({
+      type: 'start-allocation-tracking',
+    });
+  }
+
+  async stopAllocationTracking(): Promise<AllocationTrackingResponse> {
+    return (await this.sendCommand({
+      type: 'stop-allocation-tracking',
+    })) as AllocationTrackingResponse;
+  }
+
+  async getMetrics(): Promise<MetricsResponse> {
+    return (await this.sendCommand({
+      type: 'get-metrics',
+    })) as MetricsResponse;
+  }
+
+  async resetMetrics(): Promise<void> {
+    await this.sendCommand({
+      type: 'reset-metrics',
+    });
+  }
+
+  async flushTrace(): Promise<string> {
+    const response = (await this.sendCommand({
+      type: 'flush-trace',
+    })) as FlushTraceResponse;
+    return response.path;
+  }
+
+  async getStallReport(reset = false): Promise<StallReport> {
+    return (await this.sendCommand({
+      type: 'get-stall-report',
+      args: {reset},
+    })) as StallReport;
+  }
+
+  async getAppMetrics(): Promise<AppMetricsSnapshot> {
+    const response = (await this.sendCommand({
+      type: 'get-app-metrics',
+    })) as AppMetricsResponse;
+    return response.metrics;
+  }
+
+  async setAppMetricsInterval(intervalMs: number): Promise<void> {
+    await this.sendCommand({
+      type: 'set-app-metrics-interval',
+      args: {'interval-ms': intervalMs},
+    });
+  }
+
+  getStreamedAppMetrics(): AppMetricsSnapshot {
+    return this.appMetrics.getSnapshot();
+  }
+
+  async setEventPolicy(
+    name: string,
+    policy: EventPolicy,
+    intervalMs = 0
+  ): Promise<void> {
+    await this.sendCommand({
+      type: 'set-event-policy',
+      args: {name, policy, 'interval-ms': intervalMs},
+    });
+  }
+
   async getComponentVisibility(componentId: string): Promise<boolean> {
     const response = (await this.sendCommand({
       type: 'get-component-visibility',
@@ -0,0 +1,34 @@
+import {AppMetricsEvent, AppMetricsSnapshot} from './responses';
+
+export class AppMetricsStream {
+  private current: AppMetricsSnapshot = {
+    counters: {},
+    gauges: {},
+    histograms: {},
+  };
+  private lastTime = 0;
+
+  push(event: AppMetricsEvent) {
+    const {counters = {}, gauges = {}, histograms = {}} = event.metrics;
+
+    for (const [name, delta] of Object.entries(counters)) {
+      this.current.counters[name] = (this.current.counters[name] ?? 0) + delta;
+    }
+
+    Object.assign(this.current.gauges, gauges);
+    Object.assign(this.current.histograms, histograms);
+    this.lastTime = event['time-ms'];
+  }
+
+  getSnapshot(): AppMetricsSnapshot {
+    return {
+      counters: {...this.current.counters},
+      gauges: {...this.current.gauges},
+      histograms: {...this.current.histograms},
+    };
+  }
+
+  getLastSampleTime(): number {
+    return this.lastTime;
+  }
+}
@@ -19,44 +19,20 @@ export function toBuffer(data: object) {
   return buffer;
 }
 
-export function isValid(buffer: Buffer): boolean {
-  if (buffer.length < constants.HEADER_SIZE) {
-    return true;
-  }
-
-  return buffer.readUInt32LE(constants.MAGIC_OFFSET) == constants.MAGIC;
-}
+export const HEADER_SIZE = constants.HEADER_SIZE;
 
-interface NextResponse {
-  response?: Response | Error;
-  bytesConsumed: number;
-}
-
-export function getNextResponse(buffer: Buffer): NextResponse {
-  if (buffer.length < constants.HEADER_SIZE) {
-    return {bytesConsumed: 0};
+export function readPayloadSize(header: Buffer): number | undefined {
+  if (header.readUInt32LE(constants.MAGIC_OFFSET) !== constants.MAGIC) {
+    return undefined;
   }
 
-  const dataSize = buffer.readUInt32LE(constants.SIZE_OFFSET);
-
-  if (buffer.length < constants.HEADER_SIZE + dataSize) {
-    return {bytesConsumed: 0};
-  }
-
-  const rawResponse = buffer
-    .subarray(constants.DATA_OFFSET, constants.DATA_OFFSET + dataSize)
-    .toString();
-
-  let response: Response | Error;
+  return header.readUInt32LE(constants.SIZE_OFFSET);
+}
 
+export function parsePayload(payload: Buffer): Response | Error {
   try {
-    response = JSON.parse(rawResponse) as Response;
+    return JSON.parse(payload.toString()) as Response;
   } catch (error) {
-    response = new Error(`Invalid JSON in response: ${error}`);
+    return new Error(`Invalid JSON in response: ${error}`);
   }
-
-  return {
-    response,
-    bytesConsumed: constants.HEADER_SIZE + dataSize,
-  };
 }
@@ -8,3 +8,47 @@ export interface SentCommand extends Command {
   onReceived(response?: object): void;
   onError(error: Error): void;
 }
+
+export interface ScreenshotOptions {
+  region?: {x: number; y: number; width: number; height: number};
+  scale?: number;
+  maxSize?: number;
+}
+
+export interface TypeTextOptions {
+  componentId?: string;
+  windowId?: string;
+  delayMs?: number;
+  method?: 'key-press' | 'insert';
+}
+
+export interface GesturePoint {
+  x: number;
+  y: number;
+  timeMs: number;
+  buttons?: string;
+  modifiers?: string;
+  wheelX?: number;
+  wheelY?: number;
+}
+
+export interface MouseGestureOptions {
+  windowId?: string;
+  stepMs?: number;
+  instant?: boolean;
+}
+
+export interface WaitForIdleOptions {
+  quietMs?: number;
+  timeoutMs?: number;
+}
+
+export interface ScriptStep {
+  type: string;
+  args?: object;
+  expect?: Record<string, unknown>;
+  wait?: boolean;
+  timeoutMs?: number;
+}
+
+export type EventPolicy = 'unlimited' | 'keep-latest' | 'batch';
@@ -1,6 +1,7 @@
 import {AppConnection} from '.';
 import {AccessibilityResponse} from './responses';
 import {DEFAULT_TIMEOUT} from './app-connection';
+import {ScreenshotOptions, TypeTextOptions} from './commands';
 
 export class ComponentHandle {
   appConnection: AppConnection;
@@ -125,6 +126,21 @@ export class ComponentHandle {
     await this.appConnection.keyPress(key, modifiers, this.componentID);
   }
 
+  async typeText(text: string, options: TypeTextOptions = {}) {
+    await this.appConnection.typeText(text, {
+      ...options,
+      componentId: this.componentID,
+    });
+  }
+
+  async drag(
+    from: {x: number; y: number},
+    to: {x: number; y: number},
+    durationMs?: number
+  ) {
+    await this.appConnection.drag(this.componentID, from, to, durationMs);
+  }
+
   async isFocused(): Promise<boolean> {
     return (
       (await this.appConnection.getFocusedComponent()) === this.componentID
@@ -142,7 +158,11 @@ export class ComponentHandle {
     return this.appConnection.countComponents(childID, this.componentID);
   }
 
-  async saveScreenshot(outFileName: string) {
-    await this.appConnection.saveScreenshot(this.componentID, outFileName);
+  async saveScreenshot(outFileName: string, options?: ScreenshotOptions) {
+    await this.appConnection.saveScreenshot(
+      this.componentID,
+      outFileName,
+      options
+    );
   }
 }
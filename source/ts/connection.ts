@@ -7,30 +7,30 @@ import {Socket} from 'net';
 import {Command} from '.';
 import {SentCommand} from './commands';
 import {toBuffer} from './binary-protocol';
-import {Event, EventResponse, Response, ResponseType} from './responses';
+import {EventResponse, Response, ResponseType} from './responses';
+import {
+  EventMatchingFunction,
+  EventRetention,
+  EventStore,
+  DEFAULT_EVENT_RETENTION,
+} from './event-store';
 
-export type EventMatchingFunction = (event: Event) => boolean;
-
-interface WaitingEvent {
-  name: string;
-  matchingFunction?: EventMatchingFunction;
-  onReceived(event: object): void;
-  onError(): void;
-}
+export type {EventMatchingFunction} from './event-store';
 
 export class Connection extends EventEmitter {
   responseStream: ResponseStream;
   sentCommands: SentCommand[];
-  receivedEvents: EventResponse[];
-  waitingEvents: WaitingEvent[];
+  events: EventStore;
   socket: Socket;
 
-  constructor(socket: Socket) {
+  constructor(
+    socket: Socket,
+    eventRetention: EventRetention = DEFAULT_EVENT_RETENTION
+  ) {
     super();
     this.responseStream = new ResponseStream();
     this.sentCommands = [];
-    this.receivedEvents = [];
-    this.waitingEvents = [];
+    this.events = new EventStore(eventRetention);
     this.socket = socket;
 
     this.socket.on('close', () => this.emit('disconnect'));
@@ -82,21 +82,10 @@ export class Connection extends EventEmitter {
 
   async waitForEvent(
     name: string,
-    matchingFunction?: (event: object) => boolean,
+    matchingFunction?: EventMatchingFunction,
     timeout?: number
   ) {
-    return new Promise((resolve, reject) => {
-      if (timeout) {
-        setTimeout(reject, timeout);
-      }
-      this.waitingEvents.push({
-        name,
-        matchingFunction,
-        onReceived: resolve,
-        onError: reject,
-      });
-      this.notifyWaitingEvents();
-    });
+    return this.events.waitFor(name, matchingFunction, timeout);
   }
 
   responseReceived(response: Response) {
@@ -121,40 +110,12 @@ export class Connection extends EventEmitter {
 
   eventReceived(event: EventResponse) {
     if (event.name) {
-      this.receivedEvents.push(event);
-      this.notifyWaitingEvents();
+      this.events.add(event);
+      this.emit('event', event);
     }
   }
 
   clearEvents() {
-    this.receivedEvents = [];
-  }
-
-  notifyWaitingEvents() {
-    this.waitingEvents = this.waitingEvents.filter((waitingEvent) => {
-      let removeElement = false;
-
-      this.receivedEvents.forEach((receivedEvent) => {
-        if (waitingEvent.name !== receivedEvent.name) {
-          return;
-        }
-
-        if (
-          waitingEvent.matchingFunction &&
-          !waitingEvent.matchingFunction(receivedEvent.data)
-        ) {
-          return;
-        }
-
-        if (!waitingEvent.onReceived) {
-          return;
-        }
-
-        waitingEvent.onReceived(receivedEvent.data);
-        removeElement = true;
-      });
-
-      return !removeElement;
-    });
+    this.events.clear();
   }
 }
@@ -0,0 +1,194 @@
+import {EventResponse, ResponseData} from './responses';
+
+export type EventMatchingFunction = (event: ResponseData) => boolean;
+
+export interface EventRetention {
+  maxEventsPerName?: number;
+  maxAgeMs?: number;
+  // Overrides maxEventsPerName for the events named here
+  maxEventsByName?: Record<string, number>;
+}
+
+export const DEFAULT_EVENT_RETENTION: EventRetention = {
+  maxEventsPerName: 1000,
+};
+
+interface StoredEvent {
+  event: EventResponse;
+  receivedAt: number;
+}
+
+interface Waiter {
+  matchingFunction?: EventMatchingFunction;
+  resolve(data: ResponseData): void;
+  timer?: NodeJS.Timeout;
+}
+
+class EventQueue {
+  private events: StoredEvent[] = [];
+  private head = 0;
+  waiters = new Set<Waiter>();
+
+  constructor(readonly name: string) {}
+
+  get length() {
+    return this.events.length - this.head;
+  }
+
+  push(event: StoredEvent) {
+    this.events.push(event);
+  }
+
+  dropOldest(count: number) {
+    this.head += Math.min(count, this.length);
+
+    if (this.head > 1024 && this.head * 2 > this.events.length) {
+      this.events = this.events.slice(this.head);
+      this.head = 0;
+    }
+  }
+
+  dropOlderThan(time: number) {
+    let count = 0;
+    while (
+      count < this.length &&
+      this.events[this.head + count].receivedAt < time
+    ) {
+      count++;
+    }
+    this.dropOldest(count);
+  }
+
+  find(matchingFunction?: EventMatchingFunction): StoredEvent | undefined {
+    for (let index = this.head; index < this.events.length; index++) {
+      const stored = this.events[index];
+      if (!matchingFunction || matchingFunction(stored.event.data)) {
+        return stored;
+      }
+    }
+    return undefined;
+  }
+
+  toArray(): EventResponse[] {
+    return this.events.slice(this.head).map((stored) => stored.event);
+  }
+}
+
+export class EventStore {
+  private queues = new Map<string, EventQueue>();
+  private retention: EventRetention;
+
+  constructor(retention: EventRetention = DEFAULT_EVENT_RETENTION) {
+    this.retention = retention;
+  }
+
+  setRetention(retention: EventRetention) {
+    this.retention = retention;
+    for (const queue of this.queues.values()) {
+      this.trim(queue, Date.now());
+    }
+  }
+
+  add(event: EventResponse, receivedAt = Date.now()) {
+    const queue = this.getQueue(event.name);
+
+    for (const waiter of queue.waiters) {
+      if (!waiter.matchingFunction || waiter.matchingFunction(event.data)) {
+        this.removeWaiter(queue, waiter);
+        waiter.resolve(event.data);
+      }
+    }
+
+    queue.push({event, receivedAt});
+    this.trim(queue, receivedAt);
+  }
+
+  waitFor(
+    name: string,
+    matchingFunction?: EventMatchingFunction,
+    timeout?: number
+  ): Promise<ResponseData> {
+    const queue = this.getQueue(name);
+    this.trim(queue, Date.now());
+
+    const existing = queue.find(matchingFunction);
+    if (existing) {
+      return Promise.resolve(existing.event.data);
+    }
+
+    return new Promise((resolve, reject) => {
+      const waiter: Waiter = {matchingFunction, resolve};
+
+      if (timeout) {
+        waiter.timer = setTimeout(() => {
+          this.removeWaiter(queue, waiter);
+          reject(new Error(`Timed out waiting for event '${name}'`));
+        }, timeout);
+      }
+
+      queue.waiters.add(waiter);
+    });
+  }
+
+  getEvents(name: string): EventResponse[] {
+    const queue = this.queues.get(name);
+    if (!queue) {
+      return [];
+    }
+
+    this.trim(queue, Date.now());
+    return queue.toArray();
+  }
+
+  getNumEvents(): number {
+    let total = 0;
+    for (const queue of this.queues.values()) {
+      total += queue.length;
+    }
+    return total;
+  }
+
+  getNumWaiters(): number {
+    let total = 0;
+    for (const queue of this.queues.values()) {
+      total += queue.waiters.size;
+    }
+    return total;
+  }
+
+  clear() {
+    for (const [name, queue] of this.queues) {
+      queue.dropOldest(queue.length);
+      if (queue.waiters.size === 0) {
+        this.queues.delete(name);
+      }
+    }
+  }
+
+  private getQueue(name: string): EventQueue {
+    let queue = this.queues.get(name);
+    if (!queue) {
+      queue = new EventQueue(name);
+      this.queues.set(name, queue);
+    }
+    return queue;
+  }
+
+  private removeWaiter(queue: EventQueue, waiter: Waiter) {
+    clearTimeout(waiter.timer);
+    queue.waiters.delete(waiter);
+  }
+
+  private trim(queue: EventQueue, now: number) {
+    const {maxEventsPerName, maxEventsByName, maxAgeMs} = this.retention;
+    const maxEvents = maxEventsByName?.[queue.name] ?? maxEventsPerName;
+
+    if (maxEvents !== undefined && queue.length > maxEvents) {
+      queue.dropOldest(queue.length - maxEvents);
+    }
+
+    if (maxAgeMs !== undefined) {
+      queue.dropOlderThan(now - maxAgeMs);
+    }
+  }
+}
@@ -1,6 +1,36 @@
 export {AppConnection} from './app-connection';
+export {AppMetricsStream} from './app-metrics';
 export {EnvironmentVariables} from './app-process';
-export {Command} from './commands';
+export {
+  Command,
+  EventPolicy,
+  GesturePoint,
+  MouseGestureOptions,
+  ScreenshotOptions,
+  ScriptStep,
+  TypeTextOptions,
+  WaitForIdleOptions,
+} from './commands';
 export {ComponentHandle} from './component-handle';
 export {pollUntil, waitForResult} from './poll';
-export {Response, Event} from './responses';
+export {
+  Response,
+  Event,
+  AllocationCounts,
+  AllocationTrackingResponse,
+  AppMetricsSnapshot,
+  CommandMetrics,
+  ComponentPaintProfile,
+  LatencySummary,
+  MemoryStatsResponse,
+  MetricsResponse,
+  PaintProfileResponse,
+  RunScriptResponse,
+  ScriptStepResult,
+  Stall,
+  StallReport,
+  StartupTimes,
+  TimeResponse,
+  WaitForIdleResponse,
+} from './responses';
+export {ScreenshotFrame, ScreenshotRecording} from './screenshot-delta';
@@ -1,43 +1,88 @@
 import {EventEmitter} from 'events';
-import {getNextResponse, isValid} from './binary-protocol';
-import {strict as assert} from 'assert';
+import {HEADER_SIZE, parsePayload, readPayloadSize} from './binary-protocol';
 
 export class ResponseStream extends EventEmitter {
-  data: Buffer;
+  #header = Buffer.alloc(HEADER_SIZE);
+  #headerBytes = 0;
+  #payloadSize?: number;
+  #payload?: Buffer;
+  #payloadBytes = 0;
+  #invalid = false;
 
-  constructor() {
-    super();
-    this.data = Buffer.alloc(0);
+  push(data: Uint8Array) {
+    const chunk = Buffer.isBuffer(data)
+      ? data
+      : Buffer.from(data.buffer, data.byteOffset, data.byteLength);
+
+    let offset = 0;
+
+    do {
+      if (this.#invalid) {
+        this.emit('error', new Error('Invalid header'));
+        return;
+      }
+
+      offset =
+        this.#payloadSize === undefined
+          ? this.#readHeader(chunk, offset)
+          : this.#readPayload(chunk, offset, this.#payloadSize);
+    } while (
+      offset < chunk.length ||
+      this.#payloadSize === 0 ||
+      this.#invalid
+    );
   }
 
-  #checkForData() {
-    if (!isValid(this.data)) {
-      this.emit('error', new Error('Invalid header'));
-      return;
+  #readHeader(chunk: Buffer, offset: number): number {
+    const copied = chunk.copy(
+      this.#header,
+      this.#headerBytes,
+      offset,
+      offset + HEADER_SIZE - this.#headerBytes
+    );
+    this.#headerBytes += copied;
+
+    if (this.#headerBytes === HEADER_SIZE) {
+      this.#payloadSize = readPayloadSize(this.#header);
+      this.#invalid = this.#payloadSize === undefined;
     }
 
-    const nextResponse = getNextResponse(this.data);
+    return offset + copied;
+  }
 
-    if (nextResponse.bytesConsumed === 0) {
-      return;
+  #readPayload(chunk: Buffer, offset: number, size: number): number {
+    const available = chunk.length - offset;
+
+    // The whole payload is in this chunk, so parse it in place without copying
+    if (!this.#payload && available >= size) {
+      this.#emitPayload(chunk.subarray(offset, offset + size));
+      return offset + size;
     }
 
-    this.data = this.data.subarray(nextResponse.bytesConsumed);
+    this.#payload ??= Buffer.allocUnsafe(size);
 
-    assert(!!nextResponse.response);
+    const copied = chunk.copy(this.#payload, this.#payloadBytes, offset);
+    this.#payloadBytes += copied;
 
-    if (nextResponse.response instanceof Error) {
-      this.emit('error', nextResponse.response);
-      this.#checkForData();
-      return;
+    if (this.#payloadBytes === size) {
+      this.#emitPayload(this.#payload);
     }
 
-    this.emit('response', nextResponse.response);
-    this.#checkForData();
+    return offset + copied;
   }
 
-  push(data: Uint8Array) {
-    this.data = Buffer.concat([this.data, data]);
-    this.#checkForData();
+  #emitPayload(payload: Buffer) {
+    this.#headerBytes = 0;
+    this.#payloadSize = undefined;
+    this.#payload = undefined;
+    this.#payloadBytes = 0;
+
+    const response = parsePayload(payload);
+
+    if (response instanceof Error) {
+      this.emit('error', response);
+    } else {
+      this.emit('response', response);
+    }
   }
 }
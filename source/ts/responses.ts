@@ -6,6 +6,45 @@ export interface ScreenshotResponse {
   image: string;
 }
 
+export interface ScreenshotDeltaRect {
+  x: number;
+  y: number;
+  width: number;
+  height: number;
+  pixels: string;
+}
+
+export interface ScreenshotDeltaResponse {
+  keyframe: boolean;
+  width: number;
+  height: number;
+  rects: ScreenshotDeltaRect[];
+}
+
+export interface StartCaptureResponse {
+  'capture-id': number;
+  'width': number;
+  'height': number;
+}
+
+export interface StopCaptureResponse {
+  'capture-id': number;
+  'captured': number;
+  'dropped': number;
+  'missed': number;
+}
+
+export interface CapturedFrame {
+  'capture-id': number;
+  'index': number;
+  'timestamp': number;
+  'image': string;
+}
+
+export interface CaptureResult extends StopCaptureResponse {
+  frames: CapturedFrame[];
+}
+
 export interface ComponentVisibilityResponse {
   showing: boolean;
   exists: boolean;
@@ -53,6 +92,141 @@ export interface GetFocusedComponentResponse {
   'component-id': string;
 }
 
+export interface LatencySummary {
+  count: number;
+  mean: number;
+  p50: number;
+  p90: number;
+  p99: number;
+  max: number;
+}
+
+export interface CommandMetrics {
+  count: number;
+  read: LatencySummary;
+  queued: LatencySummary;
+  search: LatencySummary;
+  handler: LatencySummary;
+  serialize: LatencySummary;
+  write: LatencySummary;
+}
+
+export interface MetricsResponse {
+  commands: Record<string, CommandMetrics>;
+}
+
+export interface FlushTraceResponse {
+  path: string;
+}
+
+export interface Stall {
+  'start-ms': number;
+  'duration-ms': number;
+}
+
+export interface StallReport {
+  'threshold-ms': number;
+  'heartbeats': number;
+  'heartbeat-latency-us': LatencySummary;
+  'max-stall-ms': number;
+  'stall-count': number;
+  'stalls': Stall[];
+}
+
+export interface AppMetricsSnapshot {
+  counters: Record<string, number>;
+  gauges: Record<string, number>;
+  histograms: Record<string, LatencySummary>;
+}
+
+export interface AppMetricsResponse {
+  metrics: AppMetricsSnapshot;
+}
+
+export interface AppMetricsEvent {
+  'time-ms': number;
+  'metrics': Partial<AppMetricsSnapshot>;
+}
+
+export interface WaitForIdleResponse {
+  'waited-ms': number;
+  'quiet-ms': number;
+  'busy-probes': number;
+  'repaint-requests': number;
+}
+
+export interface MemoryStatsResponse {
+  'rss-bytes': number;
+  'peak-rss-bytes': number;
+  'virtual-bytes': number;
+  'data-bytes': number;
+  'heap-size-bytes'?: number;
+  'heap-rss-bytes'?: number;
+  'allocations'?: number;
+  'frees'?: number;
+}
+
+export interface AllocationCounts {
+  allocations: number;
+  bytes: number;
+}
+
+export interface AllocationTrackingResponse {
+  process: {
+    app: AllocationCounts;
+    library: AllocationCounts;
+    frees: number;
+  };
+  commands: Record<
+    string,
+    {
+      count: number;
+      app: AllocationCounts;
+      library: AllocationCounts;
+    }
+  >;
+}
+
+export interface ComponentPaintProfile {
+  'test-id': string;
+  'paints': number;
+  'total-ms': number;
+  'mean-ms': number;
+  'max-ms': number;
+}
+
+export interface PaintProfileResponse {
+  'duration-ms': number;
+  'total-ms': number;
+  'components': ComponentPaintProfile[];
+}
+
+export interface TimeResponse {
+  'time-ms': number;
+  'scale': number;
+}
+
+export interface ScriptStepResult {
+  'type': string;
+  'duration-ms': number;
+  'attempts'?: number;
+}
+
+export interface RunScriptResponse {
+  steps: ScriptStepResult[];
+}
+
+export interface HandshakeEvent {
+  'process-start-ms': number;
+  'test-centre-created-ms': number;
+  'connect-attempts-ms': number[];
+  'ready-ms': number;
+}
+
+export interface StartupTimes extends HandshakeEvent {
+  'launch-ms': number;
+}
+
 export enum ResponseType {
   response = 'response',
   event = 'event',
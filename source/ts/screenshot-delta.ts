@@ -0,0 +1,93 @@
+import zlib from 'zlib';
+import {ScreenshotDeltaResponse} from './responses';
+
+const BYTES_PER_PIXEL = 4;
+
+export interface ScreenshotFrame {
+  width: number;
+  height: number;
+  pixels: Buffer;
+}
+
+export function applyScreenshotDelta(
+  delta: ScreenshotDeltaResponse,
+  previous?: ScreenshotFrame
+): ScreenshotFrame {
+  const frameSize = delta.width * delta.height * BYTES_PER_PIXEL;
+
+  if (!delta.keyframe && previous?.pixels.length !== frameSize) {
+    throw new Error('Screenshot delta needs a previous frame of the same size');
+  }
+
+  const pixels =
+    delta.keyframe || !previous
+      ? Buffer.alloc(frameSize)
+      : Buffer.from(previous.pixels);
+
+  for (const rect of delta.rects) {
+    const rectPixels = zlib.inflateSync(Buffer.from(rect.pixels, 'base64'));
+    const rowSize = rect.width * BYTES_PER_PIXEL;
+
+    for (let row = 0; row < rect.height; row++) {
+      const offset = ((rect.y + row) * delta.width + rect.x) * BYTES_PER_PIXEL;
+      rectPixels.copy(pixels, offset, row * rowSize, (row + 1) * rowSize);
+    }
+  }
+
+  return {width: delta.width, height: delta.height, pixels};
+}
+
+export class ScreenshotRecording {
+  deltas: ScreenshotDeltaResponse[];
+  #lastFrame?: {index: number; frame: ScreenshotFrame};
+
+  constructor() {
+    this.deltas = [];
+  }
+
+  get length() {
+    return this.deltas.length;
+  }
+
+  push(delta: ScreenshotDeltaResponse): number {
+    if (this.deltas.length === 0 && !delta.keyframe) {
+      throw new Error('The first recorded screenshot must be a keyframe');
+    }
+
+    this.deltas.push(delta);
+    return this.deltas.length - 1;
+  }
+
+  getFrame(index: number): ScreenshotFrame {
+    if (index < 0 || index >= this.deltas.length) {
+      throw new RangeError(`No recorded screenshot at index ${index}`);
+    }
+
+    let start = index;
+    while (start > 0 && !this.deltas[start].keyframe) {
+      start--;
+    }
+
+    let frame: ScreenshotFrame | undefined;
+
+    if (
+      this.#lastFrame &&
+      this.#lastFrame.index >= start &&
+      this.#lastFrame.index <= index
+    ) {
+      frame = this.#lastFrame.frame;
+      start = this.#lastFrame.index + 1;
+    }
+
+    for (let current = start; current <= index; current++) {
+      frame = applyScreenshotDelta(this.deltas[current], frame);
+    }
+
+    if (!frame) {
+      throw new Error(`Failed to rebuild screenshot ${index}`);
+    }
+
+    this.#lastFrame = {index, frame};
+    return frame;
+  }
+}
@@ -0,0 +1,55 @@
+import {AppMetricsStream} from '../source/ts/app-metrics';
+
+const summary = (count: number) => ({
+  count,
+  mean: 1,
+  p50: 1,
+  p90: 1,
+  p99: 1,
+  max: 1,
+});
+
+describe('AppMetricsStream', () => {
+  it('starts empty', () => {
+    const stream = new AppMetricsStream();
+
+    expect(stream.getSnapshot()).toEqual({
+      counters: {},
+      gauges: {},
+      histograms: {},
+    });
+    expect(stream.getLastSampleTime()).toEqual(0);
+  });
+
+  it('sums counter deltas', () => {
+    const stream = new AppMetricsStream();
+    stream.push({'time-ms': 10, 'metrics': {counters: {underruns: 2}}});
+    stream.push({'time-ms': 20, 'metrics': {counters: {underruns: 3}}});
+
+    expect(stream.getSnapshot().counters).toEqual({underruns: 5});
+    expect(stream.getLastSampleTime()).toEqual(20);
+  });
+
+  it('keeps the latest gauge and histogram values', () => {
+    const stream = new AppMetricsStream();
+    stream.push({
+      'time-ms': 10,
+      'metrics': {gauges: {voices: 4}, histograms: {render: summary(1)}},
+    });
+    stream.push({'time-ms': 20, 'metrics': {gauges: {voices: 2}}});
+
+    const snapshot = stream.getSnapshot();
+    expect(snapshot.gauges).toEqual({voices: 2});
+    expect(snapshot.histograms).toEqual({render: summary(1)});
+  });
+
+  it('returns snapshots that are not changed by later samples', () => {
+    const stream = new AppMetricsStream();
+    stream.push({'time-ms': 10, 'metrics': {counters: {hits: 1}}});
+    const snapshot = stream.getSnapshot();
+
+    stream.push({'time-ms': 20, 'metrics': {counters: {hits: 1}}});
+
+    expect(snapshot.counters).toEqual({hits: 1});
+  });
+});
@@ -0,0 +1,136 @@
+import {EventStore} from '../source/ts/event-store';
+import {EventResponse, ResponseType} from '../source/ts/responses';
+
+const event = (name: string, data: object = {}): EventResponse => ({
+  uuid: '',
+  type: ResponseType.event,
+  name,
+  data,
+});
+
+describe('EventStore', () => {
+  afterEach(() => {
+    jest.useRealTimers();
+  });
+
+  it('resolves waiters with events that have already arrived', async () => {
+    const store = new EventStore();
+    store.add(event('ready', {value: 1}));
+
+    await expect(store.waitFor('ready')).resolves.toEqual({value: 1});
+  });
+
+  it('resolves waiters when a matching event arrives', async () => {
+    const store = new EventStore();
+    const promise = store.waitFor('level', (data) => 'value' in data);
+
+    store.add(event('level', {}));
+    store.add(event('other', {value: 1}));
+    store.add(event('level', {value: 2}));
+
+    await expect(promise).resolves.toEqual({value: 2});
+    expect(store.getNumWaiters()).toEqual(0);
+  });
+
+  it('rejects and removes waiters that time out', async () => {
+    jest.useFakeTimers();
+    const store = new EventStore();
+    const promise = store.waitFor('never', undefined, 100);
+
+    jest.advanceTimersByTime(100);
+
+    await expect(promise).rejects.toThrow(
+      "Timed out waiting for event 'never'"
+    );
+    expect(store.getNumWaiters()).toEqual(0);
+  });
+
+  it('cancels the timeout once the event arrives', async () => {
+    jest.useFakeTimers();
+    const store = new EventStore();
+    const promise = store.waitFor('ready', undefined, 100);
+
+    store.add(event('ready'));
+
+    await expect(promise).resolves.toEqual({});
+    expect(jest.getTimerCount()).toEqual(0);
+  });
+
+  it('keeps at most the configured number of events per name', () => {
+    const store = new EventStore({maxEventsPerName: 3});
+
+    for (let index = 0; index < 5; index++) {
+      store.add(event('level', {index}));
+    }
+    store.add(event('other'));
+
+    expect(store.getEvents('level').map((stored) => stored.data)).toEqual([
+      {index: 2},
+      {index: 3},
+      {index: 4},
+    ]);
+    expect(store.getNumEvents()).toEqual(4);
+  });
+
+  it('drops events older than the configured age', () => {
+    const store = new EventStore({maxAgeMs: 1000});
+    const now = Date.now();
+
+    store.add(event('level', {index: 0}), now - 2000);
+    store.add(event('level', {index: 1}), now);
+
+    expect(store.getEvents('level').map((stored) => stored.data)).toEqual([
+      {index: 1},
+    ]);
+  });
+
+  it('clears stored events but keeps waiters', async () => {
+    const store = new EventStore();
+    store.add(event('ready', {value: 1}));
+    store.clear();
+
+    const promise = store.waitFor('ready');
+    expect(store.getNumEvents()).toEqual(0);
+
+    store.add(event('ready', {value: 2}));
+    await expect(promise).resolves.toEqual({value: 2});
+  });
+
+  it('keeps the configured number of events for a named event', () => {
+    const store = new EventStore({
+      maxEventsPerName: 3,
+      maxEventsByName: {frame: 1},
+    });
+
+    for (let index = 0; index < 5; index++) {
+      store.add(event('frame', {index}));
+      store.add(event('level', {index}));
+    }
+
+    expect(store.getEvents('frame').map((stored) => stored.data)).toEqual([
+      {index: 4},
+    ]);
+    expect(store.getEvents('level')).toHaveLength(3);
+  });
+
+  it('handles 100k events with many waiters', async () => {
+    const store = new EventStore({maxEventsPerName: 100});
+    const numEvents = 100000;
+    const numNames = 100;
+
+    const waiters = Array.from({length: numNames}, (_, name) =>
+      store.waitFor(`event-${name}`, (data) => 'last' in data)
+    );
+
+    for (let index = 0; index < numEvents; index++) {
+      store.add(event(`event-${index % numNames}`, {index}));
+    }
+
+    for (let name = 0; name < numNames; name++) {
+      store.add(event(`event-${name}`, {last: true}));
+    }
+
+    await expect(Promise.all(waiters)).resolves.toHaveLength(numNames);
+    expect(store.getNumEvents()).toEqual(numNames * 100);
+  });
+});
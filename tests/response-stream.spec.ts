@@ -95,6 +95,34 @@ describe('Response Stream', () => {
     expect(onResponse).toHaveBeenNthCalledWith(1, response1);
     expect(onResponse).toHaveBeenNthCalledWith(2, response2);
   });
+
+  it('parses a large response split across many chunks', () => {
+    const response = {data: 'x'.repeat(1024 * 1024)};
+    const buffer = toBuffer(response);
+    const chunkSize = 3000;
+
+    for (let offset = 0; offset < buffer.length; offset += chunkSize) {
+      responseStream.push(buffer.subarray(offset, offset + chunkSize));
+    }
+
+    expect(onError).not.toHaveBeenCalled();
+    expect(onResponse).toHaveBeenCalledTimes(1);
+    expect(onResponse).toHaveBeenCalledWith(response);
+  });
+
+  it('parses a response whose header is split across chunks', () => {
+    const buffer = Buffer.concat([
+      toBuffer({hello: 'world'}),
+      toBuffer(exampleResponse),
+    ]);
+    const split = toBuffer({hello: 'world'}).length + 5;
+
+    responseStream.push(buffer.subarray(0, split));
+    responseStream.push(buffer.subarray(split));
+
+    expect(onResponse).toHaveBeenCalledTimes(2);
+    expect(onResponse).toHaveBeenNthCalledWith(2, exampleResponse);
+  });
 });
 
 const exampleResponse = {
@@ -0,0 +1,75 @@
+import zlib from 'zlib';
+import {ScreenshotDeltaResponse} from '../source/ts/responses';
+import {
+  applyScreenshotDelta,
+  ScreenshotRecording,
+} from '../source/ts/screenshot-delta';
+
+const rect = (
+  x: number,
+  y: number,
+  width: number,
+  height: number,
+  value: number
+) => ({
+  x,
+  y,
+  width,
+  height,
+  pixels: zlib
+    .deflateSync(Buffer.alloc(width * height * 4, value))
+    .toString('base64'),
+});
+
+const keyframe: ScreenshotDeltaResponse = {
+  keyframe: true,
+  width: 4,
+  height: 4,
+  rects: [rect(0, 0, 4, 4, 1)],
+};
+
+const delta: ScreenshotDeltaResponse = {
+  keyframe: false,
+  width: 4,
+  height: 4,
+  rects: [rect(2, 1, 2, 2, 7)],
+};
+
+const pixelAt = (pixels: Buffer, x: number, y: number) =>
+  pixels[(y * 4 + x) * 4];
+
+describe('Screenshot deltas', () => {
+  it('rebuilds a keyframe', () => {
+    const frame = applyScreenshotDelta(keyframe);
+    expect(frame.width).toBe(4);
+    expect(frame.height).toBe(4);
+    expect(frame.pixels.every((value) => value === 1)).toBeTruthy();
+  });
+
+  it('applies changed rects on top of the previous frame', () => {
+    const frame = applyScreenshotDelta(delta, applyScreenshotDelta(keyframe));
+    expect(pixelAt(frame.pixels, 0, 0)).toBe(1);
+    expect(pixelAt(frame.pixels, 2, 1)).toBe(7);
+    expect(pixelAt(frame.pixels, 3, 2)).toBe(7);
+    expect(pixelAt(frame.pixels, 1, 2)).toBe(1);
+    expect(pixelAt(frame.pixels, 3, 3)).toBe(1);
+  });
+
+  it('rejects a delta without a previous frame', () => {
+    expect(() => applyScreenshotDelta(delta)).toThrow();
+  });
+
+  it('rebuilds recorded frames on demand', () => {
+    const recording = new ScreenshotRecording();
+    recording.push(keyframe);
+    recording.push(delta);
+
+    expect(pixelAt(recording.getFrame(1).pixels, 2, 1)).toBe(7);
+    expect(pixelAt(recording.getFrame(0).pixels, 2, 1)).toBe(1);
+  });
+
+  it('requires recordings to start with a keyframe', () => {
+    const recording = new ScreenshotRecording();
+    expect(() => recording.push(delta)).toThrow();
+  });
+});